@@ -32,11 +32,45 @@ class PlayVerb(VerbExtension):
             help='size of message queue rosbag tries to hold in memory to help deterministic '
                  'playback. Larger size will result in larger memory needs but might prevent '
                  'delay of message playback.')
+        parser.add_argument(
+            '--read-ahead-queue-bytes', type=int, default=0,
+            help='maximum size in bytes of the messages rosbag tries to hold in memory, in '
+                 'addition to --read-ahead-queue-size. Defaults to 0, which means unbounded. '
+                 'If set, a --read-ahead-queue-size of 0 means unbounded as well.')
+        parser.add_argument(
+            '--topics', type=str, default=[], nargs='+',
+            help='topics to replay, separated by space. If none specified, all topics will be '
+                 'replayed.')
+        parser.add_argument(
+            '--spin-threshold', type=int, default=0,
+            help='time in us before publishing a message in which the player busy-waits '
+                 'instead of sleeping. Makes publish times more precise, but costs CPU time.')
+        parser.add_argument(
+            '--rate', type=float, default=1.0,
+            help='factor by which playback is faster than recording, defaults to 1.0. '
+                 'E.g. 2.0 plays twice as fast, 0.5 half as fast.')
+        parser.add_argument(
+            '--max-speed', action='store_true',
+            help='publish messages as fast as possible, without respecting their timing, and '
+                 'report the achieved throughput. Overrides --rate.')
+        parser.add_argument(
+            '--publishing-threads', type=int, default=1,
+            help='number of threads publishing messages, defaults to 1. With more threads, the '
+                 'topics are distributed over the threads, so a slow topic only delays the topics '
+                 'of its own thread, as long as its backlog fits into the read-ahead queue.')
 
     def main(self, *, args):  # noqa: D102
         bag_file = args.bag_file
         if not os.path.exists(bag_file):
             return "[ERROR] [ros2bag] bag file '{}' does not exist!".format(bag_file)
+        if args.spin_threshold < 0:
+            return '[ERROR] [ros2bag] spin threshold must not be negative!'
+        if args.read_ahead_queue_size < 0 or args.read_ahead_queue_bytes < 0:
+            return '[ERROR] [ros2bag] read ahead queue limits must not be negative!'
+        if args.publishing_threads < 1:
+            return '[ERROR] [ros2bag] at least one publishing thread is needed!'
+        if args.rate <= 0:
+            return '[ERROR] [ros2bag] rate must be positive!'
         # NOTE(hidmic): in merged install workspaces on Windows, Python entrypoint lookups
         #               combined with constrained environments (as imposed by colcon test)
         #               may result in DLL loading failures when attempting to import a C
@@ -47,4 +81,10 @@ class PlayVerb(VerbExtension):
             uri=bag_file,
             storage_id=args.storage,
             node_prefix=NODE_NAME_PREFIX,
-            read_ahead_queue_size=args.read_ahead_queue_size)
+            read_ahead_queue_size=args.read_ahead_queue_size,
+            topics=args.topics,
+            spin_threshold_us=args.spin_threshold,
+            rate=args.rate,
+            max_speed=args.max_speed,
+            read_ahead_queue_bytes=args.read_ahead_queue_bytes,
+            publishing_threads=args.publishing_threads)
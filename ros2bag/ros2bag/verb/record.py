@@ -29,6 +29,12 @@ class RecordVerb(VerbExtension):
             help='recording all topics, required if no topics are listed explicitly.')
         parser.add_argument(
             'topics', nargs='*', help='topics to be recorded')
+        parser.add_argument(
+            '-e', '--regex', default='',
+            help='record topics matching the regular expression, in addition to the listed topics')
+        parser.add_argument(
+            '-x', '--exclude', default='',
+            help='exclude topics matching the regular expression from recording')
         parser.add_argument(
             '-o', '--output',
             help='destination of the bagfile to create, \
@@ -46,8 +52,20 @@ class RecordVerb(VerbExtension):
                  'startup will be recorded')
         parser.add_argument(
             '-p', '--polling-interval', type=int, default=100,
-            help='time in ms to wait between querying available topics for recording. It has no '
-                 'effect if --no-discovery is enabled.'
+            help='time in ms to wait between querying available topics for recording, if the '
+                 'middleware does not signal graph changes. It has no effect if --no-discovery '
+                 'is enabled.'
+        )
+        parser.add_argument(
+            '--threads', type=int, default=1,
+            help='number of threads receiving messages, defaults to 1. With more threads, '
+                 'topics are received in parallel. 0 uses one thread per core.'
+        )
+        parser.add_argument(
+            '--defer-indices', action='store_true',
+            help='create the indices of the bag when the recording ends instead of maintaining '
+                 'them while writing. Writing is faster, but a bag whose recording is killed '
+                 'has no indices and reads slowly.'
         )
         self._subparser = parser
 
@@ -58,8 +76,10 @@ class RecordVerb(VerbExtension):
             return "[ERROR] [ros2bag]: Could not create bag folder '{}'.".format(uri)
 
     def main(self, *, args):  # noqa: D102
-        if args.all and args.topics:
-            return 'Invalid choice: Can not specify topics and -a at the same time.'
+        if args.all and (args.topics or args.regex):
+            return 'Invalid choice: Can not specify topics or -e and -a at the same time.'
+        if args.threads < 0:
+            return 'Invalid choice: The number of threads must not be negative.'
 
         uri = args.output or datetime.datetime.now().strftime('rosbag2_%Y_%m_%d-%H_%M_%S')
 
@@ -83,8 +103,11 @@ class RecordVerb(VerbExtension):
                 node_prefix=NODE_NAME_PREFIX,
                 all=True,
                 no_discovery=args.no_discovery,
-                polling_interval=args.polling_interval)
-        elif args.topics and len(args.topics) > 0:
+                polling_interval=args.polling_interval,
+                number_of_threads=args.threads,
+                exclude=args.exclude,
+                defer_indices=args.defer_indices)
+        elif (args.topics and len(args.topics) > 0) or args.regex:
             # NOTE(hidmic): in merged install workspaces on Windows, Python entrypoint lookups
             #               combined with constrained environments (as imposed by colcon test)
             #               may result in DLL loading failures when attempting to import a C
@@ -99,7 +122,11 @@ class RecordVerb(VerbExtension):
                 node_prefix=NODE_NAME_PREFIX,
                 no_discovery=args.no_discovery,
                 polling_interval=args.polling_interval,
-                topics=args.topics)
+                topics=args.topics,
+                number_of_threads=args.threads,
+                regex=args.regex,
+                exclude=args.exclude,
+                defer_indices=args.defer_indices)
         else:
             self._subparser.print_help()
 
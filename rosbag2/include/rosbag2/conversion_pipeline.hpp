@@ -0,0 +1,154 @@
+// Copyright 2018, Bosch Software Innovations GmbH.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROSBAG2__CONVERSION_PIPELINE_HPP_
+#define ROSBAG2__CONVERSION_PIPELINE_HPP_
+
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "rosbag2/converter.hpp"
+#include "rosbag2/converter_options.hpp"
+#include "rosbag2/serialization_format_converter_factory_interface.hpp"
+#include "rosbag2/types.hpp"
+#include "rosbag2/visibility_control.hpp"
+
+// This is necessary because of using stl types here. It is completely safe, because
+// a) the member is not accessible from the outside
+// b) there are no inline functions.
+#ifdef _WIN32
+# pragma warning(push)
+# pragma warning(disable:4251)
+#endif
+
+namespace rosbag2
+{
+
+/**
+ * Converts messages between two serialization formats on a pool of worker threads, each with its
+ * own Converter. Messages are converted out of order, but a reorder buffer hands them out in the
+ * order in which they were pushed, i.e. in timestamp order for messages read from a bag.
+ *
+ * Messages are meant to be pushed and popped by a single thread, or by one producer and one
+ * consumer. Topics may be added at any time.
+ */
+class ROSBAG2_PUBLIC ConversionPipeline
+{
+public:
+  /**
+   * \param converter_options Input and output serialization format
+   * \param converter_factory Factory to load the converter plugins of every worker from
+   * \param number_of_threads Number of worker threads, at least one is started
+   * \param max_pending_messages Number of messages which may be pushed but not yet popped.
+   * 0 allows 16 messages per worker thread.
+   * \throws runtime_error if a converter plugin does not exist
+   */
+  ConversionPipeline(
+    const ConverterOptions & converter_options,
+    std::shared_ptr<SerializationFormatConverterFactoryInterface> converter_factory,
+    size_t number_of_threads,
+    size_t max_pending_messages = 0);
+
+  /**
+   * Stops the worker threads. Pending messages are discarded.
+   */
+  ~ConversionPipeline();
+
+  void add_topic(const std::string & topic, const std::string & type);
+
+  /**
+   * Take the buffers of converted messages from the given pool instead of the default one.
+   */
+  void set_message_pool(std::shared_ptr<SerializedMessagePool> message_pool);
+
+  /**
+   * Hand a message to the worker threads for conversion. Blocks while the pipeline is full.
+   *
+   * \param message Message in the input format, of a topic added before
+   */
+  void push(std::shared_ptr<const SerializedBagMessage> message);
+
+  /**
+   * Take the converted message which was pushed first, waiting for its conversion if necessary.
+   *
+   * \return message in the output format
+   * \throws runtime_error if no message is pending, or the exception thrown by the conversion
+   */
+  std::shared_ptr<SerializedBagMessage> pop();
+
+  /**
+   * \return number of messages which were pushed but not yet popped
+   */
+  size_t get_pending_count() const;
+
+  /**
+   * \return true if push() would block
+   */
+  bool is_full() const;
+
+  /**
+   * Discard all pending messages. Waits for the conversions in progress to finish.
+   */
+  void clear();
+
+private:
+  struct Worker
+  {
+    std::unique_ptr<Converter> converter;
+    // Guards the converter, whose topics may be added while it converts
+    std::mutex converter_mutex;
+    std::thread thread;
+  };
+
+  struct Slot
+  {
+    std::shared_ptr<const SerializedBagMessage> input_message;
+    std::shared_ptr<SerializedBagMessage> output_message;
+    std::exception_ptr error;
+    bool is_converted;
+  };
+
+  static constexpr size_t pending_messages_per_thread_ = 16;
+
+  void run_worker(Worker & worker);
+
+  std::vector<std::unique_ptr<Worker>> workers_;
+
+  mutable std::mutex mutex_;
+  // Signals the workers that a message was pushed or that they have to stop
+  std::condition_variable work_condition_;
+  // Signals producer and consumer that a message was converted or popped
+  std::condition_variable result_condition_;
+  // Reorder buffer of the pending messages, indexed by their sequence number modulo its size
+  std::vector<Slot> slots_;
+  uint64_t next_push_sequence_;
+  uint64_t next_conversion_sequence_;
+  uint64_t next_pop_sequence_;
+  size_t busy_workers_;
+  bool is_stopping_;
+};
+
+}  // namespace rosbag2
+
+#ifdef _WIN32
+# pragma warning(pop)
+#endif
+
+#endif  // ROSBAG2__CONVERSION_PIPELINE_HPP_
@@ -25,6 +25,7 @@
 #include "rosbag2/serialization_format_converter_factory_interface.hpp"
 #include "rosbag2/converter_interfaces/serialization_format_converter.hpp"
 #include "rosbag2/types.hpp"
+#include "rosbag2/types/introspection_message.hpp"
 #include "rosbag2/visibility_control.hpp"
 
 // This is necessary because of using stl types here. It is completely safe, because
@@ -46,6 +47,11 @@ struct ConverterTypeSupport
   const rosidl_message_type_support_t * introspection_type_support;
 };
 
+/**
+ * Converts serialized messages between two serialization formats by deserializing them into ROS
+ * messages. The ROS message of every topic is reused for all of its messages, so a Converter must
+ * not be used by several threads at once.
+ */
 class ROSBAG2_PUBLIC Converter
 {
 public:
@@ -74,13 +80,51 @@ public:
   std::shared_ptr<SerializedBagMessage>
   convert(std::shared_ptr<const SerializedBagMessage> message);
 
+  /**
+   * Converts several messages at once. The messages of every topic are handed to the converter
+   * plugins in batches of at most 16 messages or, unless a single message exceeds it, 4 MiB of
+   * serialized data, which bounds the deserialized messages kept for reuse.
+   *
+   * \param messages Messages to convert, of any topics added before
+   * \returns Converted messages, in the same order
+   */
+  std::vector<std::shared_ptr<SerializedBagMessage>>
+  convert(const std::vector<std::shared_ptr<const SerializedBagMessage>> & messages);
+
   void add_topic(const std::string & topic, const std::string & type);
 
+  /**
+   * Take the buffers of converted messages from the given pool instead of the default one.
+   */
+  void set_message_pool(std::shared_ptr<SerializedMessagePool> message_pool);
+
 private:
+  struct ConverterTopic
+  {
+    ConverterTypeSupport type_support;
+    // Allocated on demand and reused for all following messages of the topic. Batches need one
+    // message each, up to max_batch_messages_, single conversions use the first one.
+    std::vector<std::shared_ptr<rosbag2_introspection_message_t>> ros_messages;
+    // Size of the previous converted message, used to size the next output buffer
+    size_t last_serialized_size;
+  };
+
   std::shared_ptr<SerializationFormatConverterFactoryInterface> converter_factory_;
   std::unique_ptr<converter_interfaces::SerializationFormatDeserializer> input_converter_;
   std::unique_ptr<converter_interfaces::SerializationFormatSerializer> output_converter_;
-  std::unordered_map<std::string, ConverterTypeSupport> topics_and_types_;
+  std::unordered_map<std::string, ConverterTopic> topics_;
+  std::shared_ptr<SerializedMessagePool> message_pool_;
+
+  static constexpr size_t max_batch_messages_ = 16;
+  static constexpr size_t max_batch_bytes_ = 4 * 1024 * 1024;
+
+  void reserve_ros_messages(ConverterTopic & topic, size_t count);
+  void convert_topic_batch(
+    ConverterTopic & topic,
+    const std::vector<std::shared_ptr<const SerializedBagMessage>> & topic_messages,
+    std::vector<std::shared_ptr<SerializedBagMessage>> & output_messages);
+  std::shared_ptr<SerializedBagMessage> make_output_message(
+    const ConverterTopic & topic, const SerializedBagMessage & input_message);
 };
 
 }  // namespace rosbag2
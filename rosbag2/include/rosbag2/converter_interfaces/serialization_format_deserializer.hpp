@@ -16,6 +16,7 @@
 #define ROSBAG2__CONVERTER_INTERFACES__SERIALIZATION_FORMAT_DESERIALIZER_HPP_
 
 #include <memory>
+#include <vector>
 
 #include "rosbag2/types/introspection_message.hpp"
 #include "rosbag2/types.hpp"
@@ -35,6 +36,24 @@ public:
     std::shared_ptr<const rosbag2::SerializedBagMessage> serialized_message,
     const rosidl_message_type_support_t * type_support,
     std::shared_ptr<rosbag2_introspection_message_t> ros_message) = 0;
+
+  /**
+   * Deserialize several messages of the same type at once. Plugins may override this to set up
+   * the deserialization once per batch. The default implementation deserializes one by one.
+   *
+   * \param serialized_messages Messages of the type given by the type support
+   * \param type_support Type support of all messages
+   * \param ros_messages One allocated ROS message per serialized message, in the same order
+   */
+  virtual void deserialize_batch(
+    const std::vector<std::shared_ptr<const rosbag2::SerializedBagMessage>> & serialized_messages,
+    const rosidl_message_type_support_t * type_support,
+    const std::vector<std::shared_ptr<rosbag2_introspection_message_t>> & ros_messages)
+  {
+    for (size_t i = 0; i < serialized_messages.size(); ++i) {
+      deserialize(serialized_messages[i], type_support, ros_messages[i]);
+    }
+  }
 };
 
 
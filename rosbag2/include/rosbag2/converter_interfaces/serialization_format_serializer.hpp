@@ -16,6 +16,7 @@
 #define ROSBAG2__CONVERTER_INTERFACES__SERIALIZATION_FORMAT_SERIALIZER_HPP_
 
 #include <memory>
+#include <vector>
 
 #include "rosbag2/types/introspection_message.hpp"
 #include "rosbag2/types.hpp"
@@ -35,6 +36,25 @@ public:
     std::shared_ptr<const rosbag2_introspection_message_t> ros_message,
     const rosidl_message_type_support_t * type_support,
     std::shared_ptr<rosbag2::SerializedBagMessage> serialized_message) = 0;
+
+  /**
+   * Serialize several messages of the same type at once. Plugins may override this to set up
+   * the serialization once per batch. The default implementation serializes one by one.
+   *
+   * \param ros_messages Messages of the type given by the type support
+   * \param type_support Type support of all messages
+   * \param serialized_messages One message with an initialized buffer per ROS message, in the
+   * same order
+   */
+  virtual void serialize_batch(
+    const std::vector<std::shared_ptr<const rosbag2_introspection_message_t>> & ros_messages,
+    const rosidl_message_type_support_t * type_support,
+    const std::vector<std::shared_ptr<rosbag2::SerializedBagMessage>> & serialized_messages)
+  {
+    for (size_t i = 0; i < ros_messages.size(); ++i) {
+      serialize(ros_messages[i], type_support, serialized_messages[i]);
+    }
+  }
 };
 
 }  // namespace converter_interfaces
@@ -15,13 +15,17 @@
 #ifndef ROSBAG2__SEQUENTIAL_READER_HPP_
 #define ROSBAG2__SEQUENTIAL_READER_HPP_
 
+#include <deque>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
+#include "rcutils/time.h"
 #include "rosbag2_storage/storage_factory.hpp"
 #include "rosbag2_storage/storage_factory_interface.hpp"
 #include "rosbag2_storage/storage_interfaces/read_only_interface.hpp"
+#include "rosbag2/conversion_pipeline.hpp"
 #include "rosbag2/converter.hpp"
 #include "rosbag2/serialization_format_converter_factory.hpp"
 #include "rosbag2/serialization_format_converter_factory_interface.hpp"
@@ -42,6 +46,13 @@ namespace rosbag2
 /**
  * The SequentialReader allows opening and reading messages of a bag. Messages will be read
  * sequentially according to timestamp.
+ *
+ * Topics may be stored in different serialization formats. Only messages of topics which are
+ * not stored in the requested output format are converted, the others are passed through.
+ *
+ * If more than one conversion thread is configured in the StorageOptions, messages are read ahead
+ * and the ones which need to be converted are converted in parallel. Setting a filter or seeking
+ * discards them and rewinds the storage to exactly behind the message read last.
  */
 class ROSBAG2_PUBLIC SequentialReader
 {
@@ -61,9 +72,9 @@ public:
    * automatically closed on destruction.
    *
    * If the `output_serialization_format` within the `converter_options` is not the same as the
-   * format of the underlying stored data, a converter will be used to automatically convert the
-   * data to the specified output format.
-   * Throws if the converter plugin does not exist.
+   * format a topic is stored in, a converter will be used to automatically convert the messages
+   * of that topic to the specified output format. Converters are loaded when the first message
+   * in their input format is read.
    *
    * \param storage_options Options to configure the storage
    * \param converter_options Options for specifying the output data format
@@ -82,6 +93,7 @@ public:
   /**
    * Read next message from storage. Will throw if no more messages are available.
    * The message will be serialized in the format given to `open`.
+   * Throws if the converter plugin needed for the message does not exist.
    *
    * Expected usage:
    * if (writer.has_next()) message = writer.read_next();
@@ -99,11 +111,60 @@ public:
    */
   virtual std::vector<TopicMetadata> get_all_topics_and_types();
 
+  /**
+   * Only read messages matching the given filter from now on. Messages of other topics are not
+   * read from the storage at all.
+   *
+   * \param storage_filter Filter to apply to the messages not yet read
+   * \throws runtime_error if the Reader is not open.
+   */
+  virtual void set_filter(const StorageFilter & storage_filter);
+
+  /**
+   * Read messages of all topics again from now on.
+   *
+   * \throws runtime_error if the Reader is not open.
+   */
+  virtual void reset_filter();
+
+  /**
+   * Continue reading with the first message whose timestamp is not smaller than the given one.
+   * Messages before that point are not read from the storage.
+   *
+   * \param timestamp Point in time to continue reading from
+   * \throws runtime_error if the Reader is not open.
+   */
+  virtual void seek(const rcutils_time_point_value_t & timestamp);
+
 private:
+  // A message read ahead, either passed through or pending in a conversion pipeline
+  struct ReadAheadMessage
+  {
+    // Position of the storage before reading the message
+    rosbag2_storage::ReadPosition read_position;
+    std::shared_ptr<SerializedBagMessage> message;
+    ConversionPipeline * conversion_pipeline;
+  };
+
+  static constexpr size_t read_ahead_messages_per_thread_ = 16;
+
   std::unique_ptr<rosbag2_storage::StorageFactoryInterface> storage_factory_;
   std::shared_ptr<SerializationFormatConverterFactoryInterface> converter_factory_;
   std::shared_ptr<rosbag2_storage::storage_interfaces::ReadOnlyInterface> storage_;
-  std::unique_ptr<Converter> converter_;
+  std::shared_ptr<SerializedMessagePool> message_pool_;
+  std::string output_serialization_format_;
+  size_t conversion_threads_;
+  // Topics which are not stored in the output serialization format, by name
+  std::unordered_map<std::string, TopicMetadata> converted_topics_;
+  // Converters and pipelines by input serialization format, created on demand
+  std::unordered_map<std::string, std::unique_ptr<Converter>> converters_;
+  std::unordered_map<std::string, std::unique_ptr<ConversionPipeline>> conversion_pipelines_;
+  std::deque<ReadAheadMessage> read_ahead_messages_;
+
+  Converter & get_converter(const std::string & input_format);
+  ConversionPipeline & get_conversion_pipeline(const std::string & input_format);
+  std::shared_ptr<SerializedBagMessage> read_next_ahead();
+  void rewind_read_ahead_messages();
 };
 
 }  // namespace rosbag2
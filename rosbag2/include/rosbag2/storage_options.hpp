@@ -15,8 +15,13 @@
 #ifndef ROSBAG2__STORAGE_OPTIONS_HPP_
 #define ROSBAG2__STORAGE_OPTIONS_HPP_
 
+#include <cstddef>
+#include <cstdint>
 #include <string>
 
+#include "rosbag2_storage/index_creation.hpp"
+#include "rosbag2_storage/write_batch_limits.hpp"
+
 namespace rosbag2
 {
 
@@ -31,6 +36,46 @@ public:
    * A value of 0 indicates that bagfile splitting will not be used.
    */
   uint64_t max_bagfile_size;
+
+  /**
+   * If true, the Writer hands messages to a dedicated storage thread instead of converting and
+   * writing them on the calling thread.
+   */
+  bool write_asynchronously = false;
+
+  /**
+   * Capacity of the asynchronous write queue in messages and in bytes of serialized data.
+   * Writing blocks while the queue is full. A value of 0 disables the respective bound.
+   */
+  size_t write_queue_max_messages = 10000;
+  uint64_t write_queue_max_bytes = 512 * 1024 * 1024;
+
+  /**
+   * Limits for grouping messages written to the storage, e.g. into SQLite transactions. Larger
+   * groups write faster, but lose more messages if the recording is interrupted.
+   */
+  rosbag2_storage::WriteBatchLimits write_batch_limits;
+
+  /**
+   * When the storage creates its indices. AFTER_WRITING speeds up writing, but a recording which
+   * is killed before the storage is closed leaves a bag without indices, which reads slowly.
+   */
+  rosbag2_storage::IndexCreation index_creation = rosbag2_storage::IndexCreation::BEFORE_WRITING;
+
+  /**
+   * Buffers of read messages are recycled by a pool keeping up to this many bytes of unused
+   * buffers. If use_huge_pages_for_reading is true, the buffers are allocated with
+   * rosbag2_storage::get_huge_page_allocator().
+   */
+  uint64_t read_buffer_pool_max_bytes = 64 * 1024 * 1024;
+  bool use_huge_pages_for_reading = false;
+
+  /**
+   * Number of threads converting messages if their serialization format has to be converted.
+   * With more than one, the SequentialReader converts messages ahead of reading them and the
+   * Writer converts the messages of its asynchronous write queue in parallel.
+   */
+  size_t conversion_threads = 1;
 };
 
 }  // namespace rosbag2
@@ -17,13 +17,18 @@
 
 #include "rosbag2_storage/bag_metadata.hpp"
 #include "rosbag2_storage/serialized_bag_message.hpp"
+#include "rosbag2_storage/serialized_message_pool.hpp"
+#include "rosbag2_storage/storage_filter.hpp"
 #include "rosbag2_storage/topic_metadata.hpp"
 
 namespace rosbag2
 {
 using BagMetadata = rosbag2_storage::BagMetadata;
 using SerializedBagMessage = rosbag2_storage::SerializedBagMessage;
+using SerializedMessagePool = rosbag2_storage::SerializedMessagePool;
+using StorageFilter = rosbag2_storage::StorageFilter;
 using TopicInformation = rosbag2_storage::TopicInformation;
+using TopicId = rosbag2_storage::TopicId;
 using TopicMetadata = rosbag2_storage::TopicMetadata;
 }  // namespace rosbag2
 
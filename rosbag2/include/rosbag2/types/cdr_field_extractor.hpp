@@ -0,0 +1,146 @@
+// Copyright 2018, Bosch Software Innovations GmbH.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROSBAG2__TYPES__CDR_FIELD_EXTRACTOR_HPP_
+#define ROSBAG2__TYPES__CDR_FIELD_EXTRACTOR_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "rcutils/time.h"
+#include "rcutils/types/uint8_array.h"
+#include "rosidl_typesupport_introspection_cpp/message_introspection.hpp"
+#include "rosbag2/visibility_control.hpp"
+
+// This is necessary because of using stl types here. It is completely safe, because
+// a) the member is not accessible from the outside
+// b) there are no inline functions.
+#ifdef _WIN32
+# pragma warning(push)
+# pragma warning(disable:4251)
+#endif
+
+namespace rosbag2
+{
+
+/**
+ * Reads a single field of CDR serialized messages without deserializing them, e.g. to index or
+ * filter messages by their header stamp.
+ *
+ * The way to the field is planned once from the introspection type support: the offset of all
+ * fields up to the first one of variable size is precomputed, only strings and sequences after
+ * it are skipped per message. The field may be nested in messages, but not in arrays.
+ */
+class ROSBAG2_PUBLIC CdrFieldExtractor
+{
+public:
+  /**
+   * \param introspection_type_support Type support of rosidl_typesupport_introspection_cpp
+   * \param field_path Names of the field and the messages containing it, separated by dots,
+   * e.g. "header.stamp"
+   * \throws runtime_error if the field does not exist, is an array or is a message other than
+   * builtin_interfaces/Time
+   */
+  CdrFieldExtractor(
+    const rosidl_message_type_support_t * introspection_type_support,
+    const std::string & field_path);
+
+  /**
+   * \return true if the field is at the same position in all messages
+   */
+  bool has_fixed_offset() const;
+
+  /**
+   * Read an integer field. Booleans, chars and octets count as integers.
+   *
+   * \param serialized_message CDR serialized message of the type given on construction
+   * \throws runtime_error if the field is no integer or the message is too short
+   */
+  int64_t read_integer(const rcutils_uint8_array_t & serialized_message) const;
+
+  /**
+   * Read a float32 or float64 field.
+   *
+   * \param serialized_message CDR serialized message of the type given on construction
+   * \throws runtime_error if the field is no floating point number or the message is too short
+   */
+  double read_floating_point(const rcutils_uint8_array_t & serialized_message) const;
+
+  /**
+   * Read a string field.
+   *
+   * \param serialized_message CDR serialized message of the type given on construction
+   * \throws runtime_error if the field is no string or the message is too short
+   */
+  std::string read_string(const rcutils_uint8_array_t & serialized_message) const;
+
+  /**
+   * Read a builtin_interfaces/Time field, e.g. a header stamp.
+   *
+   * \param serialized_message CDR serialized message of the type given on construction
+   * \return time in nanoseconds
+   * \throws runtime_error if the field is no time or the message is too short
+   */
+  rcutils_time_point_value_t read_time_point(
+    const rcutils_uint8_array_t & serialized_message) const;
+
+private:
+  // Skips a field, which may be an array or a sequence
+  struct SkipOperation
+  {
+    enum Kind {PRIMITIVES, STRINGS, WSTRINGS, MESSAGES};
+
+    Kind kind;
+    size_t primitive_size;
+    bool is_sequence;
+    // Number of elements if the field is no sequence
+    size_t count;
+    // Skips the fields of one element if the field holds messages
+    std::vector<SkipOperation> message_operations;
+  };
+
+  // Position of the field in a message. data points behind the encapsulation header.
+  struct FieldLocation
+  {
+    const uint8_t * data;
+    size_t size;
+    size_t offset;
+    bool is_byte_swapped;
+  };
+
+  static SkipOperation make_skip_operation(
+    const rosidl_typesupport_introspection_cpp::MessageMember & member);
+  static std::vector<SkipOperation> make_skip_operations(
+    const rosidl_typesupport_introspection_cpp::MessageMembers & members);
+  static bool is_fixed_size(const SkipOperation & operation);
+  static void skip(const SkipOperation & operation, FieldLocation & location);
+
+  FieldLocation locate_field(const rcutils_uint8_array_t & serialized_message) const;
+
+  // Offset of the field, or of the first field to be skipped per message, behind the header
+  size_t fixed_offset_;
+  std::vector<SkipOperation> operations_;
+  uint8_t type_id_;
+  bool is_time_;
+};
+
+}  // namespace rosbag2
+
+#ifdef _WIN32
+# pragma warning(pop)
+#endif
+
+#endif  // ROSBAG2__TYPES__CDR_FIELD_EXTRACTOR_HPP_
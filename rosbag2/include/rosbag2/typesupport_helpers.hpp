@@ -18,6 +18,7 @@
 #include <string>
 #include <tuple>
 #include <utility>
+#include <vector>
 
 #include "rosidl_generator_cpp/message_type_support_decl.hpp"
 #include "rosbag2/visibility_control.hpp"
@@ -25,10 +26,25 @@
 namespace rosbag2
 {
 
+/**
+ * Returns the typesupport of a message type. Typesupports and their libraries are cached for the
+ * lifetime of the process, so only the first request of a type loads it.
+ * This function is thread-safe.
+ *
+ * \throws std::runtime_error if the typesupport cannot be loaded.
+ */
 ROSBAG2_PUBLIC
 const rosidl_message_type_support_t *
 get_typesupport(const std::string & type, const std::string & typesupport_identifier);
 
+/**
+ * Loads the typesupports of the given message types in parallel into the cache of
+ * get_typesupport(...). Errors are ignored, they are thrown when the type is requested.
+ */
+ROSBAG2_PUBLIC
+void preload_typesupports(
+  const std::vector<std::string> & types, const std::string & typesupport_identifier);
+
 [[deprecated("use extract_type_identifier(const std::string & full_type) instead")]]
 ROSBAG2_PUBLIC
 const std::pair<std::string, std::string> extract_type_and_package(const std::string & full_type);
@@ -15,15 +15,23 @@
 #ifndef ROSBAG2__WRITER_HPP_
 #define ROSBAG2__WRITER_HPP_
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <memory>
+#include <mutex>
+#include <queue>
 #include <string>
+#include <thread>
 #include <unordered_map>
 #include <vector>
 
+#include "moodycamel/blockingconcurrentqueue.h"
 #include "rosbag2_storage/metadata_io.hpp"
 #include "rosbag2_storage/storage_factory.hpp"
 #include "rosbag2_storage/storage_factory_interface.hpp"
 #include "rosbag2_storage/storage_interfaces/read_write_interface.hpp"
+#include "rosbag2/conversion_pipeline.hpp"
 #include "rosbag2/converter.hpp"
 #include "rosbag2/serialization_format_converter_factory.hpp"
 #include "rosbag2/storage_options.hpp"
@@ -44,6 +52,13 @@ namespace rosbag2
 /**
  * The Writer allows writing messages to a new bag. For every topic, information about its type
  * needs to be added before writing the first message.
+ *
+ * If asynchronous writing is enabled in the StorageOptions, write() only enqueues the message.
+ * Conversion and storage happen in batches on a dedicated thread, which is flushed and joined
+ * on destruction. Messages which need to be converted are converted per batch there, or in
+ * parallel with more than one conversion thread configured, and stored in their original order.
+ *
+ * write() may be called concurrently, e.g. by subscriptions spinning on several threads.
  */
 class ROSBAG2_PUBLIC Writer
 {
@@ -75,9 +90,11 @@ public:
    * a message which is passed to write(...).
    *
    * \param topic_with_type name and type identifier of topic to be created
+   * \return id of the topic for write(topic_id, ...), which stays valid until the topic is removed.
+   * Creating an existing topic returns its id.
    * \throws runtime_error if the Writer is not open.
    */
-  virtual void create_topic(const TopicMetadata & topic_with_type);
+  virtual TopicId create_topic(const TopicMetadata & topic_with_type);
 
   /**
    * Remove a new topic in the underlying storage.
@@ -91,28 +108,85 @@ public:
 
   /**
    * Write a message to a bagfile. The topic needs to have been created before writing is possible.
+   * In asynchronous mode, this blocks only while the write queue is full.
    *
    * \param message to be written to the bagfile
    * \throws runtime_error if the Writer is not open.
    */
   virtual void write(std::shared_ptr<SerializedBagMessage> message);
 
+  /**
+   * Write a message of the topic with the given id to a bagfile. Unlike writing a
+   * SerializedBagMessage, this does not need to look up the topic by its name.
+   *
+   * \param topic_id id returned by create_topic(...)
+   * \param serialized_data serialized message
+   * \param time_stamp time at which the message was received
+   * \throws runtime_error if the Writer is not open or, in synchronous mode, the topic is unknown.
+   */
+  virtual void write(
+    TopicId topic_id,
+    std::shared_ptr<rcutils_uint8_array_t> serialized_data,
+    rcutils_time_point_value_t time_stamp);
+
 private:
+  struct QueuedMessage
+  {
+    // Id of the topic, or unresolved_topic_id_ if it has to be looked up by the message's name
+    TopicId topic_id;
+    std::shared_ptr<SerializedBagMessage> message;
+  };
+
+  struct WriterTopic
+  {
+    TopicInformation info;
+    TopicId storage_topic_id;
+    bool is_removed;
+  };
+
+  using WriteQueue = moodycamel::BlockingConcurrentQueue<QueuedMessage>;
+
+  static constexpr TopicId unresolved_topic_id_ = -1;
+
+  static constexpr size_t write_batch_size_ = 256;
+  static const std::chrono::milliseconds write_queue_wait_period_;
+
   std::string uri_;
   std::unique_ptr<rosbag2_storage::StorageFactoryInterface> storage_factory_;
   std::shared_ptr<SerializationFormatConverterFactoryInterface> converter_factory_;
   std::shared_ptr<rosbag2_storage::storage_interfaces::ReadWriteInterface> storage_;
   std::unique_ptr<rosbag2_storage::MetadataIo> metadata_io_;
   std::unique_ptr<Converter> converter_;
+  std::unique_ptr<ConversionPipeline> conversion_pipeline_;
+  // Topics of the messages in the conversion pipeline, in their order
+  std::queue<TopicId> converting_topic_ids_;
+  // Messages of the storage thread's current batch, which are converted together, and their topics
+  std::vector<std::shared_ptr<const SerializedBagMessage>> converting_batch_;
+  std::vector<TopicId> converting_batch_topic_ids_;
 
   // Used in bagfile splitting; specifies the best-effort maximum sub-section of a bagfile in bytes.
   uint64_t max_bagfile_size_;
 
-  // Used to track topic -> message count
-  std::unordered_map<std::string, TopicInformation> topics_names_to_info_;
+  // Topics with their message count, indexed by their id. Ids of removed topics are not reused.
+  std::vector<WriterTopic> topics_;
+  std::unordered_map<std::string, TopicId> topic_ids_;
 
   rosbag2_storage::BagMetadata metadata_;
 
+  // Guards storage_, converter_ and the metadata bookkeeping against the storage thread.
+  std::mutex storage_mutex_;
+
+  // State of the asynchronous write mode. The queue bounds are best-effort with many producers.
+  std::unique_ptr<WriteQueue> write_queue_;
+  std::thread write_thread_;
+  std::atomic<bool> is_write_thread_stopping_;
+  std::atomic<size_t> queued_messages_;
+  std::atomic<uint64_t> queued_bytes_;
+  size_t write_queue_max_messages_;
+  uint64_t write_queue_max_bytes_;
+  std::mutex queue_space_mutex_;
+  std::condition_variable queue_space_condition_;
+
   // Checks if the current recording bagfile needs to be split and rolled over to a new file.
   bool should_split_bagfile() const;
 
@@ -121,6 +195,27 @@ private:
 
   // Record TopicInformation into metadata
   void finalize_metadata();
+
+  // Looks up the id of a created topic. Requires storage_mutex_ to be held.
+  TopicId get_topic_id(const std::string & topic_name) const;
+
+  // Updates the metadata and writes the (converted) message. Requires storage_mutex_ to be held.
+  void write_to_storage(TopicId topic_id, std::shared_ptr<SerializedBagMessage> message);
+
+  // Writes the next message leaving the conversion pipeline. Requires storage_mutex_ to be held.
+  void write_next_converted_message();
+
+  // Converts and writes converting_batch_. Requires storage_mutex_ to be held.
+  void write_converted_batch();
+
+  void start_write_thread(const StorageOptions & storage_options);
+  void stop_write_thread();
+  bool has_queue_space(uint64_t message_size) const;
+  void enqueue_for_writing(TopicId topic_id, std::shared_ptr<SerializedBagMessage> message);
+  void release_queue_space(size_t message_count, uint64_t message_bytes);
+
+  // Body of the storage thread: drains the write queue in batches until stopped and empty.
+  void write_queued_messages();
 };
 
 }  // namespace rosbag2
@@ -0,0 +1,192 @@
+// Copyright 2018, Bosch Software Innovations GmbH.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "rosbag2/conversion_pipeline.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace rosbag2
+{
+
+constexpr size_t ConversionPipeline::pending_messages_per_thread_;
+
+ConversionPipeline::ConversionPipeline(
+  const ConverterOptions & converter_options,
+  std::shared_ptr<SerializationFormatConverterFactoryInterface> converter_factory,
+  size_t number_of_threads,
+  size_t max_pending_messages)
+: next_push_sequence_(0),
+  next_conversion_sequence_(0),
+  next_pop_sequence_(0),
+  busy_workers_(0),
+  is_stopping_(false)
+{
+  number_of_threads = std::max<size_t>(number_of_threads, 1);
+  if (max_pending_messages == 0) {
+    max_pending_messages = number_of_threads * pending_messages_per_thread_;
+  }
+  slots_.resize(max_pending_messages);
+
+  // Load all converters before starting any thread, so that a missing plugin leaves none running
+  for (size_t i = 0; i < number_of_threads; ++i) {
+    auto worker = std::make_unique<Worker>();
+    worker->converter = std::make_unique<Converter>(converter_options, converter_factory);
+    workers_.push_back(std::move(worker));
+  }
+  for (auto & worker : workers_) {
+    auto worker_ptr = worker.get();
+    worker->thread = std::thread([this, worker_ptr]() {run_worker(*worker_ptr);});
+  }
+}
+
+ConversionPipeline::~ConversionPipeline()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    is_stopping_ = true;
+  }
+  work_condition_.notify_all();
+  for (auto & worker : workers_) {
+    worker->thread.join();
+  }
+}
+
+void ConversionPipeline::add_topic(const std::string & topic, const std::string & type)
+{
+  for (auto & worker : workers_) {
+    std::lock_guard<std::mutex> lock(worker->converter_mutex);
+    worker->converter->add_topic(topic, type);
+  }
+}
+
+void ConversionPipeline::set_message_pool(std::shared_ptr<SerializedMessagePool> message_pool)
+{
+  for (auto & worker : workers_) {
+    std::lock_guard<std::mutex> lock(worker->converter_mutex);
+    worker->converter->set_message_pool(message_pool);
+  }
+}
+
+void ConversionPipeline::push(std::shared_ptr<const SerializedBagMessage> message)
+{
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    result_condition_.wait(lock, [this] {
+        return next_push_sequence_ - next_pop_sequence_ < slots_.size();
+      });
+    auto & slot = slots_[next_push_sequence_ % slots_.size()];
+    slot.input_message = std::move(message);
+    slot.output_message.reset();
+    slot.error = nullptr;
+    slot.is_converted = false;
+    ++next_push_sequence_;
+  }
+  work_condition_.notify_one();
+}
+
+std::shared_ptr<SerializedBagMessage> ConversionPipeline::pop()
+{
+  std::shared_ptr<SerializedBagMessage> message;
+  std::exception_ptr error;
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (next_pop_sequence_ == next_push_sequence_) {
+      throw std::runtime_error("No message is pending conversion.");
+    }
+    auto & slot = slots_[next_pop_sequence_ % slots_.size()];
+    result_condition_.wait(lock, [&slot] {return slot.is_converted;});
+    message = std::move(slot.output_message);
+    error = slot.error;
+    slot.error = nullptr;
+    ++next_pop_sequence_;
+  }
+  result_condition_.notify_all();
+
+  if (error) {
+    std::rethrow_exception(error);
+  }
+  return message;
+}
+
+size_t ConversionPipeline::get_pending_count() const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return next_push_sequence_ - next_pop_sequence_;
+}
+
+bool ConversionPipeline::is_full() const
+{
+  return get_pending_count() >= slots_.size();
+}
+
+void ConversionPipeline::clear()
+{
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    // Messages not yet taken by a worker are dropped right away, the others once converted
+    next_conversion_sequence_ = next_push_sequence_;
+    result_condition_.wait(lock, [this] {return busy_workers_ == 0;});
+    for (; next_pop_sequence_ < next_push_sequence_; ++next_pop_sequence_) {
+      auto & slot = slots_[next_pop_sequence_ % slots_.size()];
+      slot.input_message.reset();
+      slot.output_message.reset();
+      slot.error = nullptr;
+    }
+  }
+  result_condition_.notify_all();
+}
+
+void ConversionPipeline::run_worker(Worker & worker)
+{
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    work_condition_.wait(lock, [this] {
+        return is_stopping_ || next_conversion_sequence_ < next_push_sequence_;
+      });
+    if (is_stopping_) {
+      return;
+    }
+    auto & slot = slots_[next_conversion_sequence_ % slots_.size()];
+    ++next_conversion_sequence_;
+    auto input_message = std::move(slot.input_message);
+    ++busy_workers_;
+    lock.unlock();
+
+    // The slot stays in place until it is popped, which requires it to be converted
+    std::shared_ptr<SerializedBagMessage> output_message;
+    std::exception_ptr error;
+    {
+      std::lock_guard<std::mutex> converter_lock(worker.converter_mutex);
+      try {
+        output_message = worker.converter->convert(input_message);
+      } catch (...) {
+        error = std::current_exception();
+      }
+    }
+    input_message.reset();
+
+    lock.lock();
+    --busy_workers_;
+    slot.output_message = std::move(output_message);
+    slot.error = error;
+    slot.is_converted = true;
+    result_condition_.notify_all();
+  }
+}
+
+}  // namespace rosbag2
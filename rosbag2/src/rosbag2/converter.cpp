@@ -14,9 +14,11 @@
 
 #include "rosbag2/converter.hpp"
 
+#include <algorithm>
 #include <memory>
 #include <stdexcept>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -24,11 +26,13 @@
 #include "rosbag2/info.hpp"
 #include "rosbag2/typesupport_helpers.hpp"
 #include "rosbag2/storage_options.hpp"
-#include "rosbag2_storage/ros_helper.hpp"
 
 namespace rosbag2
 {
 
+constexpr size_t Converter::max_batch_messages_;
+constexpr size_t Converter::max_batch_bytes_;
+
 Converter::Converter(
   const std::string & input_format,
   const std::string & output_format,
@@ -43,7 +47,8 @@ Converter::Converter(
   input_converter_(converter_factory_->load_deserializer(
       converter_options.input_serialization_format)),
   output_converter_(converter_factory_->load_serializer(
-      converter_options.output_serialization_format))
+      converter_options.output_serialization_format)),
+  message_pool_(std::make_shared<SerializedMessagePool>())
 {
   if (!input_converter_) {
     throw std::runtime_error(
@@ -65,27 +70,119 @@ Converter::~Converter()
 std::shared_ptr<SerializedBagMessage> Converter::convert(
   std::shared_ptr<const rosbag2::SerializedBagMessage> message)
 {
-  auto ts = topics_and_types_.at(message->topic_name).rmw_type_support;
-  auto introspection_ts = topics_and_types_.at(message->topic_name).introspection_type_support;
+  auto & topic = topics_.at(message->topic_name);
+  auto ts = topic.type_support.rmw_type_support;
+  reserve_ros_messages(topic, 1);
+  const auto & ros_message = topic.ros_messages[0];
+
+  input_converter_->deserialize(message, ts, ros_message);
+  auto output_message = make_output_message(topic, *message);
+  output_converter_->serialize(ros_message, ts, output_message);
+  if (output_message->serialized_data) {
+    topic.last_serialized_size = output_message->serialized_data->buffer_length;
+  }
+  return output_message;
+}
+
+std::vector<std::shared_ptr<SerializedBagMessage>> Converter::convert(
+  const std::vector<std::shared_ptr<const SerializedBagMessage>> & messages)
+{
+  std::unordered_map<std::string, std::vector<size_t>> message_indices_by_topic;
+  for (size_t i = 0; i < messages.size(); ++i) {
+    message_indices_by_topic[messages[i]->topic_name].push_back(i);
+  }
+
+  std::vector<std::shared_ptr<SerializedBagMessage>> output_messages(messages.size());
+  std::vector<std::shared_ptr<const SerializedBagMessage>> topic_messages;
+  std::vector<std::shared_ptr<SerializedBagMessage>> topic_output_messages;
+  for (const auto & topic_message_indices : message_indices_by_topic) {
+    auto & topic = topics_.at(topic_message_indices.first);
+    const auto & message_indices = topic_message_indices.second;
+
+    // Bounded batches keep few deserialized messages alive, even for topics of large messages
+    size_t batch_start = 0;
+    while (batch_start < message_indices.size()) {
+      topic_messages.clear();
+      size_t batch_bytes = 0;
+      size_t batch_end = batch_start;
+      while (batch_end < message_indices.size() && topic_messages.size() < max_batch_messages_ &&
+        (topic_messages.empty() || batch_bytes < max_batch_bytes_))
+      {
+        const auto & message = messages[message_indices[batch_end++]];
+        batch_bytes += message->serialized_data ? message->serialized_data->buffer_length : 0;
+        topic_messages.push_back(message);
+      }
+
+      convert_topic_batch(topic, topic_messages, topic_output_messages);
+      for (size_t i = 0; i < topic_output_messages.size(); ++i) {
+        output_messages[message_indices[batch_start + i]] = std::move(topic_output_messages[i]);
+      }
+      batch_start = batch_end;
+    }
+  }
+  return output_messages;
+}
+
+void Converter::convert_topic_batch(
+  ConverterTopic & topic,
+  const std::vector<std::shared_ptr<const SerializedBagMessage>> & topic_messages,
+  std::vector<std::shared_ptr<SerializedBagMessage>> & output_messages)
+{
+  auto ts = topic.type_support.rmw_type_support;
+  reserve_ros_messages(topic, topic_messages.size());
+  std::vector<std::shared_ptr<rosbag2_introspection_message_t>> ros_messages(
+    topic.ros_messages.begin(), topic.ros_messages.begin() + topic_messages.size());
+  output_messages.clear();
+  for (const auto & message : topic_messages) {
+    output_messages.push_back(make_output_message(topic, *message));
+  }
+
+  input_converter_->deserialize_batch(topic_messages, ts, ros_messages);
+  output_converter_->serialize_batch(
+    std::vector<std::shared_ptr<const rosbag2_introspection_message_t>>(
+      ros_messages.begin(), ros_messages.end()),
+    ts, output_messages);
+
+  if (output_messages.back()->serialized_data) {
+    topic.last_serialized_size = output_messages.back()->serialized_data->buffer_length;
+  }
+}
+
+void Converter::reserve_ros_messages(ConverterTopic & topic, size_t count)
+{
   auto allocator = rcutils_get_default_allocator();
-  std::shared_ptr<rosbag2_introspection_message_t> allocated_ros_message =
-    allocate_introspection_message(introspection_ts, &allocator);
+  while (topic.ros_messages.size() < count) {
+    topic.ros_messages.push_back(
+      allocate_introspection_message(topic.type_support.introspection_type_support, &allocator));
+  }
+}
 
-  input_converter_->deserialize(message, ts, allocated_ros_message);
+std::shared_ptr<SerializedBagMessage> Converter::make_output_message(
+  const ConverterTopic & topic, const SerializedBagMessage & input_message)
+{
   auto output_message = std::make_shared<rosbag2::SerializedBagMessage>();
-  output_message->serialized_data = rosbag2_storage::make_empty_serialized_message(0);
-  output_converter_->serialize(allocated_ros_message, ts, output_message);
+  // Messages of a topic hardly differ in size, which mostly saves growing the buffer
+  auto input_size =
+    input_message.serialized_data ? input_message.serialized_data->buffer_length : 0;
+  output_message->serialized_data =
+    message_pool_->acquire(std::max(input_size, topic.last_serialized_size));
   return output_message;
 }
 
 void Converter::add_topic(const std::string & topic, const std::string & type)
 {
-  ConverterTypeSupport type_support;
-  type_support.rmw_type_support = get_typesupport(type, "rosidl_typesupport_cpp");
-  type_support.introspection_type_support =
+  ConverterTopic converter_topic;
+  converter_topic.type_support.rmw_type_support = get_typesupport(type, "rosidl_typesupport_cpp");
+  converter_topic.type_support.introspection_type_support =
     get_typesupport(type, "rosidl_typesupport_introspection_cpp");
+  converter_topic.last_serialized_size = 0;
 
-  topics_and_types_.insert({topic, type_support});
+  topics_.insert({topic, converter_topic});
+}
+
+void Converter::set_message_pool(std::shared_ptr<SerializedMessagePool> message_pool)
+{
+  message_pool_ = message_pool;
 }
 
 }  // namespace rosbag2
@@ -21,15 +21,18 @@
 #include <vector>
 
 #include "rosbag2/info.hpp"
+#include "rosbag2_storage/huge_page_allocator.hpp"
 
 namespace rosbag2
 {
 
+constexpr size_t SequentialReader::read_ahead_messages_per_thread_;
+
 SequentialReader::SequentialReader(
   std::unique_ptr<rosbag2_storage::StorageFactoryInterface> storage_factory,
   std::shared_ptr<SerializationFormatConverterFactoryInterface> converter_factory)
 : storage_factory_(std::move(storage_factory)), converter_factory_(std::move(converter_factory)),
-  converter_(nullptr)
+  conversion_threads_(1)
 {}
 
 SequentialReader::~SequentialReader()
@@ -45,28 +48,18 @@ SequentialReader::open(
   if (!storage_) {
     throw std::runtime_error("No storage could be initialized. Abort");
   }
-  auto topics = storage_->get_metadata().topics_with_message_count;
-  if (topics.empty()) {
-    return;
-  }
-
-  // Currently a bag file can only be played if all topics have the same serialization format.
-  auto storage_serialization_format = topics[0].topic_metadata.serialization_format;
-  for (const auto & topic : topics) {
-    if (topic.topic_metadata.serialization_format != storage_serialization_format) {
-      throw std::runtime_error("Topics with different rwm serialization format have been found. "
-              "All topics must have the same serialization format.");
-    }
-  }
+  message_pool_ = std::make_shared<SerializedMessagePool>(
+    storage_options.read_buffer_pool_max_bytes,
+    storage_options.use_huge_pages_for_reading ?
+    rosbag2_storage::get_huge_page_allocator() : rcutils_get_default_allocator());
+  storage_->set_message_pool(message_pool_);
+  output_serialization_format_ = converter_options.output_serialization_format;
+  conversion_threads_ = storage_options.conversion_threads;
 
-  if (converter_options.output_serialization_format != storage_serialization_format) {
-    converter_ = std::make_unique<Converter>(
-      storage_serialization_format,
-      converter_options.output_serialization_format,
-      converter_factory_);
-    auto topics = storage_->get_all_topics_and_types();
-    for (const auto & topic_with_type : topics) {
-      converter_->add_topic(topic_with_type.name, topic_with_type.type);
+  // Topics already stored in the output format are passed through without any converter
+  for (const auto & topic : storage_->get_metadata().topics_with_message_count) {
+    if (topic.topic_metadata.serialization_format != output_serialization_format_) {
+      converted_topics_[topic.topic_metadata.name] = topic.topic_metadata;
     }
   }
 }
@@ -74,7 +67,7 @@ SequentialReader::open(
 bool SequentialReader::has_next()
 {
   if (storage_) {
-    return storage_->has_next();
+    return !read_ahead_messages_.empty() || storage_->has_next();
   }
   throw std::runtime_error("Bag is not open. Call open() before reading.");
 }
@@ -82,8 +75,15 @@ bool SequentialReader::has_next()
 std::shared_ptr<SerializedBagMessage> SequentialReader::read_next()
 {
   if (storage_) {
+    if (conversion_threads_ > 1 && !converted_topics_.empty()) {
+      return read_next_ahead();
+    }
     auto message = storage_->read_next();
-    return converter_ ? converter_->convert(message) : message;
+    auto topic = converted_topics_.find(message->topic_name);
+    if (topic == converted_topics_.end()) {
+      return message;
+    }
+    return get_converter(topic->second.serialization_format).convert(message);
   }
   throw std::runtime_error("Bag is not open. Call open() before reading.");
 }
@@ -96,4 +96,113 @@ std::vector<TopicMetadata> SequentialReader::get_all_topics_and_types()
   throw std::runtime_error("Bag is not open. Call open() before reading.");
 }
 
+void SequentialReader::set_filter(const StorageFilter & storage_filter)
+{
+  if (storage_) {
+    rewind_read_ahead_messages();
+    return storage_->set_filter(storage_filter);
+  }
+  throw std::runtime_error("Bag is not open. Call open() before setting a filter.");
+}
+
+void SequentialReader::reset_filter()
+{
+  if (storage_) {
+    rewind_read_ahead_messages();
+    return storage_->reset_filter();
+  }
+  throw std::runtime_error("Bag is not open. Call open() before resetting the filter.");
+}
+
+void SequentialReader::seek(const rcutils_time_point_value_t & timestamp)
+{
+  if (storage_) {
+    rewind_read_ahead_messages();
+    return storage_->seek(timestamp);
+  }
+  throw std::runtime_error("Bag is not open. Call open() before seeking.");
+}
+
+Converter & SequentialReader::get_converter(const std::string & input_format)
+{
+  auto & converter = converters_[input_format];
+  if (!converter) {
+    auto new_converter = std::make_unique<Converter>(
+      input_format, output_serialization_format_, converter_factory_);
+    new_converter->set_message_pool(message_pool_);
+    for (const auto & topic : converted_topics_) {
+      if (topic.second.serialization_format == input_format) {
+        new_converter->add_topic(topic.second.name, topic.second.type);
+      }
+    }
+    converter = std::move(new_converter);
+  }
+  return *converter;
+}
+
+ConversionPipeline & SequentialReader::get_conversion_pipeline(const std::string & input_format)
+{
+  auto & conversion_pipeline = conversion_pipelines_[input_format];
+  if (!conversion_pipeline) {
+    // Every pipeline can take all messages read ahead, so that pushing never blocks
+    auto new_conversion_pipeline = std::make_unique<ConversionPipeline>(
+      ConverterOptions{input_format, output_serialization_format_},
+      converter_factory_,
+      conversion_threads_,
+      conversion_threads_ * read_ahead_messages_per_thread_);
+    new_conversion_pipeline->set_message_pool(message_pool_);
+    for (const auto & topic : converted_topics_) {
+      if (topic.second.serialization_format == input_format) {
+        new_conversion_pipeline->add_topic(topic.second.name, topic.second.type);
+      }
+    }
+    conversion_pipeline = std::move(new_conversion_pipeline);
+  }
+  return *conversion_pipeline;
+}
+
+std::shared_ptr<SerializedBagMessage> SequentialReader::read_next_ahead()
+{
+  // Keep the pipelines filled, so that messages are converted while earlier ones are processed
+  while (read_ahead_messages_.size() < conversion_threads_ * read_ahead_messages_per_thread_ &&
+    storage_->has_next())
+  {
+    ReadAheadMessage read_ahead_message{storage_->get_read_position(), nullptr, nullptr};
+    auto message = storage_->read_next();
+    auto topic = converted_topics_.find(message->topic_name);
+    if (topic == converted_topics_.end()) {
+      read_ahead_message.message = std::move(message);
+    } else {
+      read_ahead_message.conversion_pipeline =
+        &get_conversion_pipeline(topic->second.serialization_format);
+      read_ahead_message.conversion_pipeline->push(std::move(message));
+    }
+    read_ahead_messages_.push_back(std::move(read_ahead_message));
+  }
+  if (read_ahead_messages_.empty()) {
+    throw std::runtime_error("No more messages to read.");
+  }
+
+  // Every pipeline returns its messages in order, so popping them in reading order keeps it
+  auto read_ahead_message = std::move(read_ahead_messages_.front());
+  read_ahead_messages_.pop_front();
+  if (read_ahead_message.conversion_pipeline) {
+    return read_ahead_message.conversion_pipeline->pop();
+  }
+  return read_ahead_message.message;
+}
+
+void SequentialReader::rewind_read_ahead_messages()
+{
+  // Messages read ahead were read with the previous filter and position. Rewinding to the exact
+  // position, rather than a timestamp, does not read messages sharing the timestamp twice.
+  if (!read_ahead_messages_.empty()) {
+    for (auto & conversion_pipeline : conversion_pipelines_) {
+      conversion_pipeline.second->clear();
+    }
+    storage_->set_read_position(read_ahead_messages_.front().read_position);
+    read_ahead_messages_.clear();
+  }
+}
+
 }  // namespace rosbag2
@@ -0,0 +1,405 @@
+// Copyright 2018, Bosch Software Innovations GmbH.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "rosbag2/types/cdr_field_extractor.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "rosidl_typesupport_introspection_cpp/field_types.hpp"
+
+namespace rosbag2
+{
+
+namespace
+{
+
+using rosidl_typesupport_introspection_cpp::MessageMember;
+using rosidl_typesupport_introspection_cpp::MessageMembers;
+
+// The encapsulation header in front of the data tells its byte order
+constexpr size_t encapsulation_header_size = 4;
+constexpr size_t max_alignment = 8;
+
+const MessageMembers * get_members(const rosidl_message_type_support_t * type_support)
+{
+  return static_cast<const MessageMembers *>(type_support->data);
+}
+
+// Size of a primitive in CDR, as written by Fast CDR
+size_t get_primitive_size(uint8_t type_id)
+{
+  namespace ts = rosidl_typesupport_introspection_cpp;
+  switch (type_id) {
+    case ts::ROS_TYPE_BOOLEAN:
+    case ts::ROS_TYPE_OCTET:
+    case ts::ROS_TYPE_CHAR:
+    case ts::ROS_TYPE_UINT8:
+    case ts::ROS_TYPE_INT8:
+      return 1;
+    case ts::ROS_TYPE_UINT16:
+    case ts::ROS_TYPE_INT16:
+      return 2;
+    case ts::ROS_TYPE_FLOAT:
+    case ts::ROS_TYPE_UINT32:
+    case ts::ROS_TYPE_INT32:
+    case ts::ROS_TYPE_WCHAR:
+      return 4;
+    case ts::ROS_TYPE_DOUBLE:
+    case ts::ROS_TYPE_UINT64:
+    case ts::ROS_TYPE_INT64:
+      return 8;
+    case ts::ROS_TYPE_LONG_DOUBLE:
+      return 16;
+    default:
+      throw std::runtime_error("Unknown field type " + std::to_string(type_id));
+  }
+}
+
+size_t get_alignment(size_t primitive_size)
+{
+  return std::min(primitive_size, max_alignment);
+}
+
+size_t align(size_t offset, size_t alignment)
+{
+  return (offset + alignment - 1) & ~(alignment - 1);
+}
+
+bool is_time(const MessageMember & member)
+{
+  const auto members = get_members(member.members_);
+  return std::strcmp(members->message_namespace_, "builtin_interfaces::msg") == 0 &&
+         std::strcmp(members->message_name_, "Time") == 0;
+}
+
+bool is_host_little_endian()
+{
+  const uint16_t probe = 1;
+  uint8_t first_byte;
+  std::memcpy(&first_byte, &probe, 1);
+  return first_byte == 1;
+}
+
+template<typename T>
+T read_value(const uint8_t * data, bool is_byte_swapped)
+{
+  uint8_t bytes[sizeof(T)];
+  std::memcpy(bytes, data, sizeof(T));
+  if (is_byte_swapped) {
+    std::reverse(bytes, bytes + sizeof(T));
+  }
+  T value;
+  std::memcpy(&value, bytes, sizeof(T));
+  return value;
+}
+
+void throw_message_too_short()
+{
+  throw std::runtime_error("Serialized message is too short for its type.");
+}
+
+}  // namespace
+
+CdrFieldExtractor::CdrFieldExtractor(
+  const rosidl_message_type_support_t * introspection_type_support,
+  const std::string & field_path)
+: fixed_offset_(0), type_id_(0), is_time_(false)
+{
+  auto members = get_members(introspection_type_support);
+  std::istringstream field_names(field_path);
+  std::string field_name;
+  bool is_target_found = false;
+  while (std::getline(field_names, field_name, '.')) {
+    if (is_target_found) {
+      throw std::runtime_error("Field '" + field_path + "' is nested in a primitive.");
+    }
+    const MessageMember * field = nullptr;
+    for (uint32_t i = 0; i < members->member_count_ && !field; ++i) {
+      if (field_name == members->members_[i].name_) {
+        field = &members->members_[i];
+      } else {
+        operations_.push_back(make_skip_operation(members->members_[i]));
+      }
+    }
+    if (!field) {
+      throw std::runtime_error(
+              "Message " + std::string(members->message_name_) + " has no field " + field_name);
+    }
+    if (field->is_array_) {
+      throw std::runtime_error("Field '" + field_path + "' is an array or nested in one.");
+    }
+
+    // Nested messages are serialized in place, so the way continues with their fields
+    bool is_message = field->type_id_ == rosidl_typesupport_introspection_cpp::ROS_TYPE_MESSAGE;
+    if (is_message && field_names.peek() != std::istringstream::traits_type::eof()) {
+      members = get_members(field->members_);
+    } else if (is_message && !is_time(*field)) {
+      throw std::runtime_error("Field '" + field_path + "' is a message other than a time.");
+    } else {
+      type_id_ = field->type_id_;
+      is_time_ = is_message;
+      is_target_found = true;
+    }
+  }
+  if (!is_target_found) {
+    throw std::runtime_error("Field path '" + field_path + "' names no field.");
+  }
+
+  // Fields of fixed size in front are passed at once, without touching any message
+  FieldLocation location{nullptr, std::numeric_limits<size_t>::max(), 0, false};
+  auto first_variable_operation = std::find_if_not(
+    operations_.begin(), operations_.end(), &CdrFieldExtractor::is_fixed_size);
+  for (auto operation = operations_.begin(); operation != first_variable_operation; ++operation) {
+    skip(*operation, location);
+  }
+  operations_.erase(operations_.begin(), first_variable_operation);
+  fixed_offset_ = location.offset;
+}
+
+bool CdrFieldExtractor::has_fixed_offset() const
+{
+  return operations_.empty();
+}
+
+int64_t CdrFieldExtractor::read_integer(const rcutils_uint8_array_t & serialized_message) const
+{
+  namespace ts = rosidl_typesupport_introspection_cpp;
+  switch (type_id_) {
+    case ts::ROS_TYPE_BOOLEAN:
+    case ts::ROS_TYPE_OCTET:
+    case ts::ROS_TYPE_CHAR:
+    case ts::ROS_TYPE_UINT8:
+    case ts::ROS_TYPE_INT8:
+    case ts::ROS_TYPE_UINT16:
+    case ts::ROS_TYPE_INT16:
+    case ts::ROS_TYPE_UINT32:
+    case ts::ROS_TYPE_INT32:
+    case ts::ROS_TYPE_WCHAR:
+    case ts::ROS_TYPE_UINT64:
+    case ts::ROS_TYPE_INT64:
+      break;
+    default:
+      throw std::runtime_error("Field is no integer.");
+  }
+
+  const auto location = locate_field(serialized_message);
+  const auto data = location.data + location.offset;
+  switch (type_id_) {
+    case ts::ROS_TYPE_INT8:
+      return read_value<int8_t>(data, location.is_byte_swapped);
+    case ts::ROS_TYPE_UINT16:
+      return read_value<uint16_t>(data, location.is_byte_swapped);
+    case ts::ROS_TYPE_INT16:
+      return read_value<int16_t>(data, location.is_byte_swapped);
+    case ts::ROS_TYPE_UINT32:
+    case ts::ROS_TYPE_WCHAR:
+      return read_value<uint32_t>(data, location.is_byte_swapped);
+    case ts::ROS_TYPE_INT32:
+      return read_value<int32_t>(data, location.is_byte_swapped);
+    case ts::ROS_TYPE_UINT64:
+      return static_cast<int64_t>(read_value<uint64_t>(data, location.is_byte_swapped));
+    case ts::ROS_TYPE_INT64:
+      return read_value<int64_t>(data, location.is_byte_swapped);
+    default:
+      return read_value<uint8_t>(data, location.is_byte_swapped);
+  }
+}
+
+double CdrFieldExtractor::read_floating_point(
+  const rcutils_uint8_array_t & serialized_message) const
+{
+  namespace ts = rosidl_typesupport_introspection_cpp;
+  if (type_id_ != ts::ROS_TYPE_FLOAT && type_id_ != ts::ROS_TYPE_DOUBLE) {
+    throw std::runtime_error("Field is no floating point number.");
+  }
+
+  const auto location = locate_field(serialized_message);
+  const auto data = location.data + location.offset;
+  if (type_id_ == ts::ROS_TYPE_FLOAT) {
+    return read_value<float>(data, location.is_byte_swapped);
+  }
+  return read_value<double>(data, location.is_byte_swapped);
+}
+
+std::string CdrFieldExtractor::read_string(const rcutils_uint8_array_t & serialized_message) const
+{
+  if (type_id_ != rosidl_typesupport_introspection_cpp::ROS_TYPE_STRING) {
+    throw std::runtime_error("Field is no string.");
+  }
+
+  const auto location = locate_field(serialized_message);
+  const auto length = read_value<uint32_t>(
+    location.data + location.offset, location.is_byte_swapped);
+  if (length > location.size - location.offset - sizeof(uint32_t)) {
+    throw_message_too_short();
+  }
+  // The length includes the terminating null character
+  const auto characters = reinterpret_cast<const char *>(location.data + location.offset + 4);
+  return std::string(characters, length > 0 ? length - 1 : 0);
+}
+
+rcutils_time_point_value_t CdrFieldExtractor::read_time_point(
+  const rcutils_uint8_array_t & serialized_message) const
+{
+  if (!is_time_) {
+    throw std::runtime_error("Field is no time.");
+  }
+
+  const auto location = locate_field(serialized_message);
+  const auto data = location.data + location.offset;
+  const auto sec = read_value<int32_t>(data, location.is_byte_swapped);
+  const auto nanosec = read_value<uint32_t>(data + 4, location.is_byte_swapped);
+  return static_cast<rcutils_time_point_value_t>(sec) * 1000000000 + nanosec;
+}
+
+CdrFieldExtractor::SkipOperation CdrFieldExtractor::make_skip_operation(
+  const MessageMember & member)
+{
+  namespace ts = rosidl_typesupport_introspection_cpp;
+  SkipOperation operation;
+  operation.primitive_size = 0;
+  // Bounded sequences are serialized like unbounded ones
+  operation.is_sequence = member.is_array_ && (member.array_size_ == 0 || member.is_upper_bound_);
+  operation.count = member.is_array_ ? member.array_size_ : 1;
+  switch (member.type_id_) {
+    case ts::ROS_TYPE_STRING:
+      operation.kind = SkipOperation::STRINGS;
+      break;
+    case ts::ROS_TYPE_WSTRING:
+      operation.kind = SkipOperation::WSTRINGS;
+      break;
+    case ts::ROS_TYPE_MESSAGE:
+      operation.kind = SkipOperation::MESSAGES;
+      operation.message_operations = make_skip_operations(*get_members(member.members_));
+      break;
+    default:
+      operation.kind = SkipOperation::PRIMITIVES;
+      operation.primitive_size = get_primitive_size(member.type_id_);
+      break;
+  }
+  return operation;
+}
+
+std::vector<CdrFieldExtractor::SkipOperation> CdrFieldExtractor::make_skip_operations(
+  const MessageMembers & members)
+{
+  std::vector<SkipOperation> operations;
+  for (uint32_t i = 0; i < members.member_count_; ++i) {
+    operations.push_back(make_skip_operation(members.members_[i]));
+  }
+  return operations;
+}
+
+bool CdrFieldExtractor::is_fixed_size(const SkipOperation & operation)
+{
+  if (operation.is_sequence) {
+    return false;
+  }
+  switch (operation.kind) {
+    case SkipOperation::PRIMITIVES:
+      return true;
+    case SkipOperation::MESSAGES:
+      return std::all_of(
+        operation.message_operations.begin(), operation.message_operations.end(),
+        &CdrFieldExtractor::is_fixed_size);
+    default:
+      return false;
+  }
+}
+
+void CdrFieldExtractor::skip(const SkipOperation & operation, FieldLocation & location)
+{
+  auto read_length = [&location]() {
+      location.offset = align(location.offset, 4);
+      if (location.offset > location.size || location.size - location.offset < sizeof(uint32_t)) {
+        throw_message_too_short();
+      }
+      const auto length = read_value<uint32_t>(
+        location.data + location.offset, location.is_byte_swapped);
+      location.offset += sizeof(uint32_t);
+      return length;
+    };
+
+  const size_t count = operation.is_sequence ? read_length() : operation.count;
+  switch (operation.kind) {
+    case SkipOperation::PRIMITIVES:
+      // Fast CDR aligns arrays only if they have elements
+      if (count > 0) {
+        location.offset = align(location.offset, get_alignment(operation.primitive_size));
+        location.offset += count * operation.primitive_size;
+      }
+      break;
+    case SkipOperation::STRINGS:
+      for (size_t i = 0; i < count; ++i) {
+        location.offset += read_length();
+      }
+      break;
+    case SkipOperation::WSTRINGS:
+      // Wide characters are written as four bytes each, without terminating null character
+      for (size_t i = 0; i < count; ++i) {
+        location.offset += read_length() * 4;
+      }
+      break;
+    case SkipOperation::MESSAGES:
+      for (size_t i = 0; i < count; ++i) {
+        for (const auto & message_operation : operation.message_operations) {
+          skip(message_operation, location);
+        }
+      }
+      break;
+  }
+  if (location.offset > location.size) {
+    throw_message_too_short();
+  }
+}
+
+CdrFieldExtractor::FieldLocation CdrFieldExtractor::locate_field(
+  const rcutils_uint8_array_t & serialized_message) const
+{
+  if (serialized_message.buffer_length < encapsulation_header_size) {
+    throw_message_too_short();
+  }
+  const bool is_little_endian = (serialized_message.buffer[1] & 1) != 0;
+  FieldLocation location{
+    serialized_message.buffer + encapsulation_header_size,
+    serialized_message.buffer_length - encapsulation_header_size,
+    fixed_offset_,
+    is_little_endian != is_host_little_endian()};
+
+  for (const auto & operation : operations_) {
+    skip(operation, location);
+  }
+
+  size_t field_size;
+  if (is_time_ || type_id_ == rosidl_typesupport_introspection_cpp::ROS_TYPE_STRING) {
+    // A time starts with its int32 seconds, a string with its uint32 length
+    location.offset = align(location.offset, 4);
+    field_size = is_time_ ? 8 : 4;
+  } else {
+    field_size = get_primitive_size(type_id_);
+    location.offset = align(location.offset, get_alignment(field_size));
+  }
+  if (location.offset > location.size || location.size - location.offset < field_size) {
+    throw_message_too_short();
+  }
+  return location;
+}
+
+}  // namespace rosbag2
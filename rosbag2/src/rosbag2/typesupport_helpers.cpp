@@ -14,11 +14,18 @@
 
 #include "rosbag2/typesupport_helpers.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <future>
 #include <memory>
+#include <mutex>
 #include <stdexcept>
 #include <string>
+#include <thread>
 #include <tuple>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "ament_index_cpp/get_resources.hpp"
 #include "ament_index_cpp/get_package_prefix.hpp"
@@ -97,8 +104,62 @@ extract_type_identifier(const std::string & full_type)
   return std::make_tuple(package_name, middle_module, type_name);
 }
 
+namespace
+{
+
+// Thread-safe cache which creates every entry once. Entries are created outside of the lock, so
+// that different entries can be created in parallel, while concurrent requests of the same entry
+// wait for its creation. Failed creations are not cached.
+template<typename T>
+class CreateOnceCache
+{
+public:
+  template<typename CreateFunction>
+  T get_or_create(const std::string & key, CreateFunction create)
+  {
+    std::promise<T> promise;
+    std::shared_future<T> entry;
+    bool is_creating = false;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto entry_iterator = entries_.find(key);
+      if (entry_iterator == entries_.end()) {
+        entry = promise.get_future().share();
+        entries_.emplace(key, entry);
+        is_creating = true;
+      } else {
+        entry = entry_iterator->second;
+      }
+    }
+
+    if (is_creating) {
+      try {
+        promise.set_value(create());
+      } catch (...) {
+        promise.set_exception(std::current_exception());
+        std::lock_guard<std::mutex> lock(mutex_);
+        entries_.erase(key);
+      }
+    }
+    return entry.get();
+  }
+
+private:
+  std::mutex mutex_;
+  std::unordered_map<std::string, std::shared_future<T>> entries_;
+};
+
+// Libraries are never unloaded, as the typesupport handles point into them.
+std::shared_ptr<Poco::SharedLibrary> get_typesupport_library(const std::string & library_path)
+{
+  static CreateOnceCache<std::shared_ptr<Poco::SharedLibrary>> library_cache;
+  return library_cache.get_or_create(library_path, [&library_path]() {
+             return std::make_shared<Poco::SharedLibrary>(library_path);
+           });
+}
+
 const rosidl_message_type_support_t *
-get_typesupport(const std::string & type, const std::string & typesupport_identifier)
+load_typesupport(const std::string & type, const std::string & typesupport_identifier)
 {
   std::string package_name;
   std::string middle_module;
@@ -111,7 +172,7 @@ get_typesupport(const std::string & type, const std::string & typesupport_identi
   auto library_path = get_typesupport_library_path(package_name, typesupport_identifier);
 
   try {
-    auto typesupport_library = std::make_shared<Poco::SharedLibrary>(library_path);
+    auto typesupport_library = get_typesupport_library(library_path);
 
     auto symbol_name = typesupport_identifier + "__get_message_type_support_handle__" +
       package_name + "__" + (middle_module.empty() ? "msg" : middle_module) + "__" + type_name;
@@ -134,4 +195,42 @@ get_typesupport(const std::string & type, const std::string & typesupport_identi
   }
 }
 
+}  // namespace
+
+const rosidl_message_type_support_t *
+get_typesupport(const std::string & type, const std::string & typesupport_identifier)
+{
+  static CreateOnceCache<const rosidl_message_type_support_t *> typesupport_cache;
+  return typesupport_cache.get_or_create(
+    typesupport_identifier + "/" + type, [&type, &typesupport_identifier]() {
+      return load_typesupport(type, typesupport_identifier);
+    });
+}
+
+void preload_typesupports(
+  const std::vector<std::string> & types, const std::string & typesupport_identifier)
+{
+  const auto number_of_threads = std::min<size_t>(
+    types.size(), std::max(std::thread::hardware_concurrency(), 1u));
+  std::atomic<size_t> next_type_index(0);
+  auto preload = [&types, &typesupport_identifier, &next_type_index]() {
+      for (auto i = next_type_index++; i < types.size(); i = next_type_index++) {
+        try {
+          get_typesupport(types[i], typesupport_identifier);
+        } catch (const std::runtime_error &) {
+          // Not cached, so the error is thrown again when the typesupport is requested
+        }
+      }
+    };
+
+  std::vector<std::thread> threads;
+  for (size_t i = 1; i < number_of_threads; ++i) {
+    threads.emplace_back(preload);
+  }
+  preload();
+  for (auto & thread : threads) {
+    thread.join();
+  }
+}
+
 }  // namespace rosbag2
@@ -22,13 +22,27 @@
 #include <stdexcept>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "rosbag2/info.hpp"
+#include "rosbag2/logging.hpp"
 #include "rosbag2/storage_options.hpp"
 
 namespace rosbag2
 {
 
+namespace
+{
+uint64_t get_serialized_size(const std::shared_ptr<SerializedBagMessage> & message)
+{
+  return message->serialized_data ? message->serialized_data->buffer_length : 0;
+}
+}  // namespace
+
+constexpr size_t Writer::write_batch_size_;
+constexpr TopicId Writer::unresolved_topic_id_;
+const std::chrono::milliseconds Writer::write_queue_wait_period_ = std::chrono::milliseconds(10);
+
 Writer::Writer(
   std::unique_ptr<rosbag2_storage::StorageFactoryInterface> storage_factory,
   std::shared_ptr<SerializationFormatConverterFactoryInterface> converter_factory,
@@ -39,12 +53,21 @@ Writer::Writer(
   metadata_io_(std::move(metadata_io)),
   converter_(nullptr),
   max_bagfile_size_(rosbag2_storage::storage_interfaces::MAX_BAGFILE_SIZE_NO_SPLIT),
-  topics_names_to_info_(),
-  metadata_()
+  topics_(),
+  topic_ids_(),
+  metadata_(),
+  write_queue_(nullptr),
+  is_write_thread_stopping_(false),
+  queued_messages_(0),
+  queued_bytes_(0),
+  write_queue_max_messages_(0),
+  write_queue_max_bytes_(0)
 {}
 
 Writer::~Writer()
 {
+  stop_write_thread();
+
   if (!uri_.empty()) {
     finalize_metadata();
     metadata_io_->write_metadata(uri_, metadata_);
@@ -72,47 +95,58 @@ void Writer::open(
   if (converter_options.output_serialization_format !=
     converter_options.input_serialization_format)
   {
-    converter_ = std::make_unique<Converter>(converter_options, converter_factory_);
+    // Only the storage thread can make use of several conversion threads
+    if (storage_options.write_asynchronously && storage_options.conversion_threads > 1) {
+      conversion_pipeline_ = std::make_unique<ConversionPipeline>(
+        converter_options, converter_factory_, storage_options.conversion_threads);
+    } else {
+      converter_ = std::make_unique<Converter>(converter_options, converter_factory_);
+    }
   }
 
   storage_ = storage_factory_->open_read_write(storage_options.uri, storage_options.storage_id);
   if (!storage_) {
     throw std::runtime_error("No storage could be initialized. Abort");
   }
+  storage_->set_write_batch_limits(storage_options.write_batch_limits);
+  storage_->set_index_creation(storage_options.index_creation);
 
   uri_ = storage_options.uri;
 
   init_metadata();
+
+  if (storage_options.write_asynchronously) {
+    start_write_thread(storage_options);
+  }
 }
 
-void Writer::create_topic(const TopicMetadata & topic_with_type)
+TopicId Writer::create_topic(const TopicMetadata & topic_with_type)
 {
   if (!storage_) {
     throw std::runtime_error("Bag is not open. Call open() before writing.");
   }
 
+  std::lock_guard<std::mutex> lock(storage_mutex_);
   if (converter_) {
     converter_->add_topic(topic_with_type.name, topic_with_type.type);
   }
+  if (conversion_pipeline_) {
+    conversion_pipeline_->add_topic(topic_with_type.name, topic_with_type.type);
+  }
 
-  if (topics_names_to_info_.find(topic_with_type.name) ==
-    topics_names_to_info_.end())
-  {
-    rosbag2_storage::TopicInformation info{};
-    info.topic_metadata = topic_with_type;
-
-    const auto insert_res = topics_names_to_info_.insert(
-      std::make_pair(topic_with_type.name, info));
+  const auto topic_id_entry = topic_ids_.find(topic_with_type.name);
+  if (topic_id_entry != topic_ids_.end()) {
+    return topic_id_entry->second;
+  }
 
-    if (!insert_res.second) {
-      std::stringstream errmsg;
-      errmsg << "Failed to insert topic \"" << topic_with_type.name << "\"!";
+  rosbag2_storage::TopicInformation info{};
+  info.topic_metadata = topic_with_type;
+  const auto storage_topic_id = storage_->create_topic(topic_with_type);
 
-      throw std::runtime_error(errmsg.str());
-    }
-
-    storage_->create_topic(topic_with_type);
-  }
+  const auto topic_id = static_cast<TopicId>(topics_.size());
+  topics_.push_back({info, storage_topic_id, false});
+  topic_ids_.emplace(topic_with_type.name, topic_id);
+  return topic_id;
 }
 
 void Writer::remove_topic(const TopicMetadata & topic_with_type)
@@ -121,7 +155,11 @@ void Writer::remove_topic(const TopicMetadata & topic_with_type)
     throw std::runtime_error("Bag is not open. Call open() before removing.");
   }
 
-  if (topics_names_to_info_.erase(topic_with_type.name) > 0) {
+  std::lock_guard<std::mutex> lock(storage_mutex_);
+  const auto topic_id_entry = topic_ids_.find(topic_with_type.name);
+  if (topic_id_entry != topic_ids_.end()) {
+    topics_[topic_id_entry->second].is_removed = true;
+    topic_ids_.erase(topic_id_entry);
     storage_->remove_topic(topic_with_type);
   } else {
     std::stringstream errmsg;
@@ -138,8 +176,60 @@ void Writer::write(std::shared_ptr<SerializedBagMessage> message)
     throw std::runtime_error("Bag is not open. Call open() before writing.");
   }
 
+  if (write_queue_) {
+    enqueue_for_writing(unresolved_topic_id_, std::move(message));
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(storage_mutex_);
+  const auto topic_id = get_topic_id(message->topic_name);
+  write_to_storage(topic_id, std::move(message));
+}
+
+void Writer::write(
+  TopicId topic_id,
+  std::shared_ptr<rcutils_uint8_array_t> serialized_data,
+  rcutils_time_point_value_t time_stamp)
+{
+  if (!storage_) {
+    throw std::runtime_error("Bag is not open. Call open() before writing.");
+  }
+
+  auto message = std::make_shared<SerializedBagMessage>();
+  message->serialized_data = std::move(serialized_data);
+  message->time_stamp = time_stamp;
+
+  if (write_queue_) {
+    enqueue_for_writing(topic_id, std::move(message));
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(storage_mutex_);
+  write_to_storage(topic_id, std::move(message));
+}
+
+TopicId Writer::get_topic_id(const std::string & topic_name) const
+{
+  const auto topic_id_entry = topic_ids_.find(topic_name);
+  if (topic_id_entry == topic_ids_.end()) {
+    throw std::runtime_error(
+            "Topic '" + topic_name + "' has not been created yet! Call 'create_topic' first.");
+  }
+  return topic_id_entry->second;
+}
+
+void Writer::write_to_storage(TopicId topic_id, std::shared_ptr<SerializedBagMessage> message)
+{
+  if (topic_id < 0 || static_cast<size_t>(topic_id) >= topics_.size() ||
+    topics_[topic_id].is_removed)
+  {
+    throw std::runtime_error(
+            "Topic with id " + std::to_string(topic_id) + " has not been created yet!");
+  }
+  auto & topic = topics_[topic_id];
+
   // Update the message count for the Topic.
-  ++topics_names_to_info_.at(message->topic_name).message_count;
+  ++topic.info.message_count;
 
   const auto message_timestamp = std::chrono::time_point<std::chrono::high_resolution_clock>(
     std::chrono::nanoseconds(message->time_stamp));
@@ -148,7 +238,173 @@ void Writer::write(std::shared_ptr<SerializedBagMessage> message)
   const auto duration = message_timestamp - metadata_.starting_time;
   metadata_.duration = std::max(metadata_.duration, duration);
 
-  storage_->write(converter_ ? converter_->convert(message) : message);
+  if (conversion_pipeline_) {
+    // Only the converters need the topic name, to find the type of the message
+    message->topic_name = topic.info.topic_metadata.name;
+    if (conversion_pipeline_->is_full()) {
+      write_next_converted_message();
+    }
+    converting_topic_ids_.push(topic_id);
+    conversion_pipeline_->push(message);
+  } else if (converter_ && write_queue_) {
+    // Converted together with the rest of the storage thread's batch
+    message->topic_name = topic.info.topic_metadata.name;
+    converting_batch_topic_ids_.push_back(topic_id);
+    converting_batch_.push_back(message);
+  } else if (converter_) {
+    message->topic_name = topic.info.topic_metadata.name;
+    storage_->write(topic.storage_topic_id, converter_->convert(message));
+  } else {
+    storage_->write(topic.storage_topic_id, message);
+  }
+}
+
+void Writer::start_write_thread(const StorageOptions & storage_options)
+{
+  write_queue_max_messages_ = storage_options.write_queue_max_messages;
+  write_queue_max_bytes_ = storage_options.write_queue_max_bytes;
+  write_queue_ = std::make_unique<WriteQueue>();
+  is_write_thread_stopping_ = false;
+  write_thread_ = std::thread(&Writer::write_queued_messages, this);
+}
+
+void Writer::stop_write_thread()
+{
+  if (write_thread_.joinable()) {
+    is_write_thread_stopping_ = true;
+    write_thread_.join();
+  }
+}
+
+bool Writer::has_queue_space(uint64_t message_size) const
+{
+  // A single message is always accepted, even if it exceeds the byte bound on its own.
+  const auto messages = queued_messages_.load();
+  if (messages == 0) {
+    return true;
+  }
+  if (write_queue_max_messages_ > 0 && messages >= write_queue_max_messages_) {
+    return false;
+  }
+  return write_queue_max_bytes_ == 0 ||
+         queued_bytes_.load() + message_size <= write_queue_max_bytes_;
+}
+
+void Writer::enqueue_for_writing(TopicId topic_id, std::shared_ptr<SerializedBagMessage> message)
+{
+  const auto message_size = get_serialized_size(message);
+  if (!has_queue_space(message_size)) {
+    std::unique_lock<std::mutex> lock(queue_space_mutex_);
+    queue_space_condition_.wait(lock, [this, message_size] {
+        return has_queue_space(message_size);
+      });
+  }
+  ++queued_messages_;
+  queued_bytes_ += message_size;
+  write_queue_->enqueue({topic_id, std::move(message)});
+}
+
+void Writer::release_queue_space(size_t message_count, uint64_t message_bytes)
+{
+  {
+    // Taking the lock ensures that no producer misses the notification between its check and wait
+    std::lock_guard<std::mutex> lock(queue_space_mutex_);
+    queued_messages_ -= message_count;
+    queued_bytes_ -= message_bytes;
+  }
+  queue_space_condition_.notify_all();
+}
+
+void Writer::write_queued_messages()
+{
+  std::vector<QueuedMessage> batch(write_batch_size_);
+  while (true) {
+    // Read the flag before dequeuing so that an empty result after a stop request is final.
+    const bool is_stopping = is_write_thread_stopping_;
+    const auto message_count = write_queue_->wait_dequeue_bulk_timed(
+      batch.begin(), batch.size(), write_queue_wait_period_);
+    if (message_count == 0) {
+      if (is_stopping) {
+        return;
+      }
+      continue;
+    }
+
+    uint64_t message_bytes = 0;
+    {
+      std::lock_guard<std::mutex> lock(storage_mutex_);
+      for (size_t i = 0; i < message_count; ++i) {
+        auto & queued_message = batch[i];
+        message_bytes += get_serialized_size(queued_message.message);
+        try {
+          const auto topic_id = queued_message.topic_id == unresolved_topic_id_ ?
+            get_topic_id(queued_message.message->topic_name) : queued_message.topic_id;
+          write_to_storage(topic_id, std::move(queued_message.message));
+        } catch (const std::exception & e) {
+          ROSBAG2_LOG_ERROR_STREAM("Failed to write message: " << e.what());
+        }
+        queued_message.message.reset();
+      }
+      if (!converting_batch_.empty()) {
+        write_converted_batch();
+      }
+      while (!converting_topic_ids_.empty()) {
+        write_next_converted_message();
+      }
+    }
+    release_queue_space(message_count, message_bytes);
+  }
+}
+
+void Writer::write_next_converted_message()
+{
+  auto & topic = topics_[converting_topic_ids_.front()];
+  converting_topic_ids_.pop();
+  try {
+    storage_->write(topic.storage_topic_id, conversion_pipeline_->pop());
+  } catch (const std::exception & e) {
+    ROSBAG2_LOG_ERROR_STREAM(
+      "Failed to convert or write message on topic '" << topic.info.topic_metadata.name <<
+        "': " << e.what());
+    // The message was counted when it was queued, but never reaches the storage
+    --topic.info.message_count;
+  }
+}
+
+void Writer::write_converted_batch()
+{
+  std::vector<std::shared_ptr<SerializedBagMessage>> converted_messages;
+  try {
+    converted_messages = converter_->convert(converting_batch_);
+  } catch (const std::exception &) {
+    // Converting the messages one by one loses only the ones which fail to convert
+    converted_messages.clear();
+    for (const auto & message : converting_batch_) {
+      try {
+        converted_messages.push_back(converter_->convert(message));
+      } catch (const std::exception & e) {
+        ROSBAG2_LOG_ERROR_STREAM(
+          "Failed to convert message on topic '" << message->topic_name << "': " << e.what());
+        converted_messages.push_back(nullptr);
+      }
+    }
+  }
+  for (size_t i = 0; i < converted_messages.size(); ++i) {
+    auto & topic = topics_[converting_batch_topic_ids_[i]];
+    if (!converted_messages[i]) {
+      // The message was counted when it was queued, but never reaches the storage
+      --topic.info.message_count;
+      continue;
+    }
+    try {
+      storage_->write(topic.storage_topic_id, converted_messages[i]);
+    } catch (const std::exception & e) {
+      ROSBAG2_LOG_ERROR_STREAM("Failed to write message: " << e.what());
+      --topic.info.message_count;
+    }
+  }
+  converting_batch_.clear();
+  converting_batch_topic_ids_.clear();
 }
 
 bool Writer::should_split_bagfile() const
@@ -169,12 +425,14 @@ void Writer::finalize_metadata()
   }
 
   metadata_.topics_with_message_count.clear();
-  metadata_.topics_with_message_count.reserve(topics_names_to_info_.size());
+  metadata_.topics_with_message_count.reserve(topic_ids_.size());
   metadata_.message_count = 0;
 
-  for (const auto & topic : topics_names_to_info_) {
-    metadata_.topics_with_message_count.push_back(topic.second);
-    metadata_.message_count += topic.second.message_count;
+  for (const auto & topic : topics_) {
+    if (!topic.is_removed) {
+      metadata_.topics_with_message_count.push_back(topic.info);
+      metadata_.message_count += topic.info.message_count;
+    }
   }
 }
 
@@ -38,4 +38,28 @@ public:
       std::shared_ptr<rosbag2::SerializedBagMessage>));
 };
 
+// Creates a converter which only passes the timestamps of the messages through
+inline std::unique_ptr<MockConverter> make_time_stamp_converter()
+{
+  using ::testing::_;
+  using ::testing::Invoke;
+
+  auto converter = std::make_unique<::testing::NiceMock<MockConverter>>();
+  ON_CALL(*converter, deserialize(_, _, _)).WillByDefault(
+    Invoke([](
+      std::shared_ptr<const rosbag2::SerializedBagMessage> message,
+      const rosidl_message_type_support_t *,
+      std::shared_ptr<rosbag2_introspection_message_t> ros_message) {
+      ros_message->time_stamp = message->time_stamp;
+    }));
+  ON_CALL(*converter, serialize(_, _, _)).WillByDefault(
+    Invoke([](
+      std::shared_ptr<const rosbag2_introspection_message_t> ros_message,
+      const rosidl_message_type_support_t *,
+      std::shared_ptr<rosbag2::SerializedBagMessage> message) {
+      message->time_stamp = ros_message->time_stamp;
+    }));
+  return converter;
+}
+
 #endif  // ROSBAG2__MOCK_CONVERTER_HPP_
@@ -30,12 +30,21 @@ class MockStorage : public rosbag2_storage::storage_interfaces::ReadWriteInterfa
 {
 public:
   MOCK_METHOD2(open, void(const std::string &, rosbag2_storage::storage_interfaces::IOFlag));
-  MOCK_METHOD1(create_topic, void(const rosbag2_storage::TopicMetadata &));
+  MOCK_METHOD1(create_topic, rosbag2_storage::TopicId(const rosbag2_storage::TopicMetadata &));
   MOCK_METHOD1(remove_topic, void(const rosbag2_storage::TopicMetadata &));
+  MOCK_METHOD1(set_write_batch_limits, void(const rosbag2_storage::WriteBatchLimits &));
+  MOCK_METHOD1(set_index_creation, void(rosbag2_storage::IndexCreation));
   MOCK_METHOD0(has_next, bool());
   MOCK_METHOD0(read_next, std::shared_ptr<rosbag2_storage::SerializedBagMessage>());
   MOCK_METHOD1(write, void(std::shared_ptr<const rosbag2_storage::SerializedBagMessage>));
+  MOCK_METHOD2(write, void(
+      rosbag2_storage::TopicId, std::shared_ptr<const rosbag2_storage::SerializedBagMessage>));
   MOCK_METHOD0(get_all_topics_and_types, std::vector<rosbag2_storage::TopicMetadata>());
+  MOCK_METHOD1(set_filter, void(const rosbag2_storage::StorageFilter &));
+  MOCK_METHOD0(reset_filter, void());
+  MOCK_METHOD1(seek, void(const rcutils_time_point_value_t &));
+  MOCK_METHOD0(get_read_position, rosbag2_storage::ReadPosition());
+  MOCK_METHOD1(set_read_position, void(const rosbag2_storage::ReadPosition &));
   MOCK_METHOD0(get_metadata, rosbag2_storage::BagMetadata());
   MOCK_CONST_METHOD0(get_bagfile_size, uint64_t());
   MOCK_CONST_METHOD0(get_relative_path, std::string());
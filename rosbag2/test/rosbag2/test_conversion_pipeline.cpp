@@ -0,0 +1,152 @@
+// Copyright 2018, Bosch Software Innovations GmbH.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gmock/gmock.h>
+
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "rosbag2/conversion_pipeline.hpp"
+
+#include "mock_converter.hpp"
+#include "mock_converter_factory.hpp"
+
+using namespace testing;  // NOLINT
+
+class ConversionPipelineTest : public Test
+{
+public:
+  ConversionPipelineTest()
+  {
+    converter_factory_ = std::make_shared<NiceMock<MockConverterFactory>>();
+    ON_CALL(*converter_factory_, load_deserializer(_)).WillByDefault(
+      Invoke([this](const std::string &)
+      -> std::unique_ptr<rosbag2::converter_interfaces::SerializationFormatDeserializer> {
+        return make_converter();
+      }));
+    ON_CALL(*converter_factory_, load_serializer(_)).WillByDefault(
+      Invoke([this](const std::string &)
+      -> std::unique_ptr<rosbag2::converter_interfaces::SerializationFormatSerializer> {
+        return make_converter();
+      }));
+  }
+
+  // Passes the timestamp through, taking longer for some messages to finish them out of order
+  std::unique_ptr<MockConverter> make_converter()
+  {
+    auto converter = std::make_unique<NiceMock<MockConverter>>();
+    ON_CALL(*converter, deserialize(_, _, _)).WillByDefault(
+      Invoke([this](
+        std::shared_ptr<const rosbag2::SerializedBagMessage> message,
+        const rosidl_message_type_support_t *,
+        std::shared_ptr<rosbag2_introspection_message_t> ros_message) {
+        if (message->time_stamp == failing_time_stamp_) {
+          throw std::runtime_error("conversion failed");
+        }
+        std::this_thread::sleep_for(std::chrono::microseconds(100 * (message->time_stamp % 3)));
+        ros_message->time_stamp = message->time_stamp;
+      }));
+    ON_CALL(*converter, serialize(_, _, _)).WillByDefault(
+      Invoke([](
+        std::shared_ptr<const rosbag2_introspection_message_t> ros_message,
+        const rosidl_message_type_support_t *,
+        std::shared_ptr<rosbag2::SerializedBagMessage> message) {
+        message->time_stamp = ros_message->time_stamp;
+      }));
+    return converter;
+  }
+
+  std::unique_ptr<rosbag2::ConversionPipeline> make_pipeline(
+    size_t number_of_threads, size_t max_pending_messages)
+  {
+    auto pipeline = std::make_unique<rosbag2::ConversionPipeline>(
+      rosbag2::ConverterOptions{"rmw1_format", "rmw2_format"},
+      converter_factory_, number_of_threads, max_pending_messages);
+    pipeline->add_topic("topic", "test_msgs/BasicTypes");
+    return pipeline;
+  }
+
+  std::shared_ptr<rosbag2::SerializedBagMessage> make_message(rcutils_time_point_value_t time_stamp)
+  {
+    auto message = std::make_shared<rosbag2::SerializedBagMessage>();
+    message->topic_name = "topic";
+    message->time_stamp = time_stamp;
+    return message;
+  }
+
+  std::shared_ptr<NiceMock<MockConverterFactory>> converter_factory_;
+  rcutils_time_point_value_t failing_time_stamp_ = -1;
+};
+
+TEST_F(ConversionPipelineTest, converted_messages_are_popped_in_the_order_they_were_pushed) {
+  EXPECT_CALL(*converter_factory_, load_deserializer("rmw1_format")).Times(4);
+  EXPECT_CALL(*converter_factory_, load_serializer("rmw2_format")).Times(4);
+  auto pipeline = make_pipeline(4, 8);
+
+  std::vector<rcutils_time_point_value_t> popped_time_stamps;
+  for (rcutils_time_point_value_t time_stamp = 0; time_stamp < 100; ++time_stamp) {
+    if (pipeline->is_full()) {
+      popped_time_stamps.push_back(pipeline->pop()->time_stamp);
+    }
+    pipeline->push(make_message(time_stamp));
+  }
+  EXPECT_THAT(pipeline->get_pending_count(), Eq(8u));
+  while (pipeline->get_pending_count() > 0) {
+    popped_time_stamps.push_back(pipeline->pop()->time_stamp);
+  }
+
+  ASSERT_THAT(popped_time_stamps, SizeIs(100));
+  for (size_t i = 0; i < popped_time_stamps.size(); ++i) {
+    EXPECT_THAT(popped_time_stamps[i], Eq(static_cast<rcutils_time_point_value_t>(i)));
+  }
+}
+
+TEST_F(ConversionPipelineTest, pop_rethrows_conversion_errors_in_order) {
+  failing_time_stamp_ = 1;
+  auto pipeline = make_pipeline(2, 0);
+
+  pipeline->push(make_message(0));
+  pipeline->push(make_message(1));
+  pipeline->push(make_message(2));
+
+  EXPECT_THAT(pipeline->pop()->time_stamp, Eq(0));
+  EXPECT_THROW(pipeline->pop(), std::runtime_error);
+  EXPECT_THAT(pipeline->pop()->time_stamp, Eq(2));
+}
+
+TEST_F(ConversionPipelineTest, clear_discards_pending_messages) {
+  auto pipeline = make_pipeline(2, 0);
+
+  for (rcutils_time_point_value_t time_stamp = 0; time_stamp < 10; ++time_stamp) {
+    pipeline->push(make_message(time_stamp));
+  }
+  pipeline->clear();
+
+  EXPECT_THAT(pipeline->get_pending_count(), Eq(0u));
+  EXPECT_THROW(pipeline->pop(), std::runtime_error);
+
+  pipeline->push(make_message(42));
+  EXPECT_THAT(pipeline->pop()->time_stamp, Eq(42));
+}
+
+TEST_F(ConversionPipelineTest, constructor_throws_if_converter_plugin_does_not_exist) {
+  EXPECT_CALL(*converter_factory_, load_serializer("rmw2_format"))
+  .WillOnce(Return(ByMove(nullptr)));
+
+  EXPECT_ANY_THROW(make_pipeline(2, 0));
+}
@@ -0,0 +1,96 @@
+// Copyright 2018, Bosch Software Innovations GmbH.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gmock/gmock.h>
+
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "rosbag2/converter.hpp"
+
+#include "mock_converter.hpp"
+#include "mock_converter_factory.hpp"
+
+using namespace testing;  // NOLINT
+
+class ConverterTest : public Test
+{
+public:
+  ConverterTest()
+  {
+    converter_factory_ = std::make_shared<NiceMock<MockConverterFactory>>();
+    ON_CALL(*converter_factory_, load_deserializer(_)).WillByDefault(
+      Invoke([this](const std::string &)
+      -> std::unique_ptr<rosbag2::converter_interfaces::SerializationFormatDeserializer> {
+        auto converter = make_time_stamp_converter();
+        ON_CALL(*converter, deserialize(_, _, _)).WillByDefault(
+          Invoke([this](
+            std::shared_ptr<const rosbag2::SerializedBagMessage> message,
+            const rosidl_message_type_support_t *,
+            std::shared_ptr<rosbag2_introspection_message_t> ros_message) {
+            used_ros_messages_.insert(ros_message.get());
+            ros_message->time_stamp = message->time_stamp;
+          }));
+        return converter;
+      }));
+    ON_CALL(*converter_factory_, load_serializer(_)).WillByDefault(
+      Invoke([](const std::string &)
+      -> std::unique_ptr<rosbag2::converter_interfaces::SerializationFormatSerializer> {
+        return make_time_stamp_converter();
+      }));
+  }
+
+  std::vector<std::shared_ptr<const rosbag2::SerializedBagMessage>> make_messages(
+    size_t count, size_t size)
+  {
+    std::vector<std::shared_ptr<const rosbag2::SerializedBagMessage>> messages;
+    for (size_t i = 0; i < count; ++i) {
+      auto message = std::make_shared<rosbag2::SerializedBagMessage>();
+      message->topic_name = "topic";
+      message->time_stamp = static_cast<rcutils_time_point_value_t>(i);
+      message->serialized_data = std::make_shared<rcutils_uint8_array_t>();
+      message->serialized_data->buffer_length = size;
+      messages.push_back(message);
+    }
+    return messages;
+  }
+
+  std::shared_ptr<NiceMock<MockConverterFactory>> converter_factory_;
+  std::set<const rosbag2_introspection_message_t *> used_ros_messages_;
+};
+
+TEST_F(ConverterTest, batches_keep_a_bounded_number_of_ros_messages) {
+  rosbag2::Converter converter({"rmw1_format", "rmw2_format"}, converter_factory_);
+  converter.add_topic("topic", "test_msgs/BasicTypes");
+
+  auto converted_messages = converter.convert(make_messages(256, 8));
+
+  ASSERT_THAT(converted_messages, SizeIs(256));
+  for (size_t i = 0; i < converted_messages.size(); ++i) {
+    EXPECT_THAT(converted_messages[i]->time_stamp, Eq(static_cast<rcutils_time_point_value_t>(i)));
+  }
+  EXPECT_THAT(used_ros_messages_.size(), Le(16u));
+}
+
+TEST_F(ConverterTest, batches_of_large_messages_keep_fewer_ros_messages) {
+  rosbag2::Converter converter({"rmw1_format", "rmw2_format"}, converter_factory_);
+  converter.add_topic("topic", "test_msgs/BasicTypes");
+
+  auto converted_messages = converter.convert(make_messages(16, 2 * 1024 * 1024));
+
+  ASSERT_THAT(converted_messages, SizeIs(16));
+  EXPECT_THAT(used_ros_messages_.size(), Le(2u));
+}
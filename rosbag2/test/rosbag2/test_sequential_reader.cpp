@@ -14,6 +14,7 @@
 
 #include <gmock/gmock.h>
 
+#include <limits>
 #include <memory>
 #include <string>
 #include <utility>
@@ -57,16 +58,55 @@ public:
   }
 
   void set_storage_serialization_format(const std::string & format)
+  {
+    set_storage_topics({{"topic", "test_msgs/BasicTypes", format}});
+  }
+
+  void set_storage_topics(const std::vector<rosbag2_storage::TopicMetadata> & topics)
   {
     rosbag2_storage::BagMetadata metadata;
-    metadata.topics_with_message_count.push_back({{"", "", format}, 1});
+    for (const auto & topic : topics) {
+      metadata.topics_with_message_count.push_back({topic, 1});
+    }
     EXPECT_CALL(*storage_, get_metadata()).WillOnce(Return(metadata));
   }
 
+  // Stores messages of the given topics in turn, the given number of them sharing a timestamp.
+  // The index of a message serves as its id in read positions.
+  void expect_messages(
+    const std::vector<std::string> & topics, size_t count, size_t messages_per_time_stamp = 1)
+  {
+    for (size_t i = 0; i < count; ++i) {
+      auto message = std::make_shared<rosbag2::SerializedBagMessage>();
+      message->topic_name = topics[i % topics.size()];
+      message->time_stamp = static_cast<rcutils_time_point_value_t>(i / messages_per_time_stamp);
+      stored_messages_.push_back(message);
+    }
+    EXPECT_CALL(*storage_, has_next()).WillRepeatedly(Invoke([this]() {
+        return next_message_index_ < stored_messages_.size();
+      }));
+    EXPECT_CALL(*storage_, read_next()).WillRepeatedly(Invoke([this]() {
+        return stored_messages_[next_message_index_++];
+      }));
+    ON_CALL(*storage_, get_read_position()).WillByDefault(Invoke([this]() {
+        auto id = static_cast<int64_t>(next_message_index_) - 1;
+        return rosbag2_storage::ReadPosition{
+          id < 0 ? std::numeric_limits<rcutils_time_point_value_t>::min() :
+          stored_messages_[id]->time_stamp,
+          id};
+      }));
+    ON_CALL(*storage_, set_read_position(_)).WillByDefault(Invoke(
+        [this](const rosbag2_storage::ReadPosition & read_position) {
+          next_message_index_ = static_cast<size_t>(read_position.id + 1);
+        }));
+  }
+
   std::unique_ptr<StrictMock<MockStorageFactory>> storage_factory_;
   std::shared_ptr<NiceMock<MockStorage>> storage_;
   std::shared_ptr<StrictMock<MockConverterFactory>> converter_factory_;
   std::unique_ptr<rosbag2::SequentialReader> reader_;
+  std::vector<std::shared_ptr<rosbag2::SerializedBagMessage>> stored_messages_;
+  size_t next_message_index_ = 0;
 };
 
 TEST_F(SequentialReaderTest, read_next_uses_converters_to_convert_serialization_format) {
@@ -88,7 +128,7 @@ TEST_F(SequentialReaderTest, read_next_uses_converters_to_convert_serialization_
   reader_->read_next();
 }
 
-TEST_F(SequentialReaderTest, open_throws_error_if_converter_plugin_does_not_exist) {
+TEST_F(SequentialReaderTest, read_next_throws_error_if_converter_plugin_does_not_exist) {
   std::string storage_serialization_format = "rmw1_format";
   std::string output_format = "rmw2_format";
   set_storage_serialization_format(storage_serialization_format);
@@ -99,7 +139,8 @@ TEST_F(SequentialReaderTest, open_throws_error_if_converter_plugin_does_not_exis
   EXPECT_CALL(*converter_factory_, load_serializer(output_format))
   .WillOnce(Return(ByMove(nullptr)));
 
-  EXPECT_ANY_THROW(reader_->open(rosbag2::StorageOptions(), {"", output_format}));
+  reader_->open(rosbag2::StorageOptions(), {"", output_format});
+  EXPECT_ANY_THROW(reader_->read_next());
 }
 
 TEST_F(SequentialReaderTest,
@@ -114,3 +155,170 @@ TEST_F(SequentialReaderTest,
   reader_->open(rosbag2::StorageOptions(), {"", storage_serialization_format});
   reader_->read_next();
 }
+
+TEST_F(SequentialReaderTest, set_filter_is_forwarded_to_storage) {
+  std::string storage_serialization_format = "rmw1_format";
+  set_storage_serialization_format(storage_serialization_format);
+
+  rosbag2::StorageFilter storage_filter;
+  storage_filter.topics = {"topic"};
+  EXPECT_CALL(*storage_, set_filter(
+      Field(&rosbag2::StorageFilter::topics, ElementsAre("topic")))).Times(1);
+  EXPECT_CALL(*storage_, reset_filter()).Times(1);
+
+  reader_->open(rosbag2::StorageOptions(), {"", storage_serialization_format});
+  reader_->set_filter(storage_filter);
+  reader_->reset_filter();
+}
+
+TEST_F(SequentialReaderTest, seek_is_forwarded_to_storage) {
+  std::string storage_serialization_format = "rmw1_format";
+  set_storage_serialization_format(storage_serialization_format);
+
+  EXPECT_CALL(*storage_, seek(42)).Times(1);
+
+  reader_->open(rosbag2::StorageOptions(), {"", storage_serialization_format});
+  reader_->seek(42);
+}
+
+TEST_F(SequentialReaderTest,
+  read_next_converts_messages_ahead_in_order_and_set_filter_rewinds_to_them)
+{
+  std::string storage_serialization_format = "rmw1_format";
+  std::string output_format = "rmw2_format";
+  set_storage_serialization_format(storage_serialization_format);
+
+  EXPECT_CALL(*converter_factory_, load_deserializer(storage_serialization_format)).Times(2)
+  .WillRepeatedly(InvokeWithoutArgs(
+      []() -> std::unique_ptr<rosbag2::converter_interfaces::SerializationFormatDeserializer> {
+        return make_time_stamp_converter();
+      }));
+  EXPECT_CALL(*converter_factory_, load_serializer(output_format)).Times(2)
+  .WillRepeatedly(InvokeWithoutArgs(
+      []() -> std::unique_ptr<rosbag2::converter_interfaces::SerializationFormatSerializer> {
+        return make_time_stamp_converter();
+      }));
+
+  expect_messages({"topic"}, 50);
+  EXPECT_CALL(*storage_, set_read_position(Field(&rosbag2_storage::ReadPosition::id, 0)))
+  .Times(1);
+
+  rosbag2::StorageOptions storage_options;
+  storage_options.conversion_threads = 2;
+  reader_->open(storage_options, {"", output_format});
+  EXPECT_THAT(reader_->read_next()->time_stamp, Eq(0));
+  EXPECT_THAT(next_message_index_, Gt(1u));
+
+  reader_->set_filter(rosbag2::StorageFilter());
+  for (rcutils_time_point_value_t time_stamp = 1; time_stamp < 50; ++time_stamp) {
+    ASSERT_TRUE(reader_->has_next());
+    EXPECT_THAT(reader_->read_next()->time_stamp, Eq(time_stamp));
+  }
+  EXPECT_FALSE(reader_->has_next());
+}
+
+TEST_F(SequentialReaderTest, read_next_passes_through_topics_stored_in_output_format) {
+  set_storage_topics({
+    {"topic", "test_msgs/BasicTypes", "rmw1_format"},
+    {"output_topic", "test_msgs/BasicTypes", "rmw2_format"}});
+  expect_messages({"output_topic", "topic"}, 2);
+
+  auto format1_converter = std::make_unique<StrictMock<MockConverter>>();
+  auto format2_converter = std::make_unique<StrictMock<MockConverter>>();
+  EXPECT_CALL(*format1_converter, deserialize(_, _, _)).Times(1);
+  EXPECT_CALL(*format2_converter, serialize(_, _, _)).Times(1);
+  EXPECT_CALL(*converter_factory_, load_deserializer("rmw1_format"))
+  .WillOnce(Return(ByMove(std::move(format1_converter))));
+  EXPECT_CALL(*converter_factory_, load_serializer("rmw2_format"))
+  .WillOnce(Return(ByMove(std::move(format2_converter))));
+
+  reader_->open(rosbag2::StorageOptions(), {"", "rmw2_format"});
+  EXPECT_THAT(reader_->read_next()->topic_name, StrEq("output_topic"));
+  reader_->read_next();
+}
+
+TEST_F(SequentialReaderTest, read_next_loads_converters_per_format_when_first_needed) {
+  set_storage_topics({
+    {"topic", "test_msgs/BasicTypes", "rmw1_format"},
+    {"other_topic", "test_msgs/BasicTypes", "rmw3_format"}});
+  expect_messages({"topic", "topic", "other_topic"}, 3);
+
+  EXPECT_CALL(*converter_factory_, load_serializer("rmw2_format")).Times(2)
+  .WillRepeatedly(InvokeWithoutArgs(
+      []() -> std::unique_ptr<rosbag2::converter_interfaces::SerializationFormatSerializer> {
+        return std::make_unique<NiceMock<MockConverter>>();
+      }));
+  reader_->open(rosbag2::StorageOptions(), {"", "rmw2_format"});
+
+  EXPECT_CALL(*converter_factory_, load_deserializer("rmw1_format"))
+  .WillOnce(Return(ByMove(std::make_unique<NiceMock<MockConverter>>())));
+  reader_->read_next();
+  reader_->read_next();
+
+  EXPECT_CALL(*converter_factory_, load_deserializer("rmw3_format"))
+  .WillOnce(Return(ByMove(std::make_unique<NiceMock<MockConverter>>())));
+  reader_->read_next();
+}
+
+TEST_F(SequentialReaderTest, read_next_keeps_order_of_passed_through_and_converted_messages) {
+  set_storage_topics({
+    {"topic", "test_msgs/BasicTypes", "rmw1_format"},
+    {"output_topic", "test_msgs/BasicTypes", "rmw2_format"}});
+  expect_messages({"topic", "output_topic", "output_topic"}, 50);
+
+  EXPECT_CALL(*converter_factory_, load_deserializer("rmw1_format")).Times(2)
+  .WillRepeatedly(InvokeWithoutArgs(
+      []() -> std::unique_ptr<rosbag2::converter_interfaces::SerializationFormatDeserializer> {
+        return make_time_stamp_converter();
+      }));
+  EXPECT_CALL(*converter_factory_, load_serializer("rmw2_format")).Times(2)
+  .WillRepeatedly(InvokeWithoutArgs(
+      []() -> std::unique_ptr<rosbag2::converter_interfaces::SerializationFormatSerializer> {
+        return make_time_stamp_converter();
+      }));
+
+  rosbag2::StorageOptions storage_options;
+  storage_options.conversion_threads = 2;
+  reader_->open(storage_options, {"", "rmw2_format"});
+  for (rcutils_time_point_value_t time_stamp = 0; time_stamp < 50; ++time_stamp) {
+    ASSERT_TRUE(reader_->has_next());
+    EXPECT_THAT(reader_->read_next()->time_stamp, Eq(time_stamp));
+  }
+  EXPECT_FALSE(reader_->has_next());
+}
+
+TEST_F(SequentialReaderTest, set_filter_does_not_read_messages_sharing_a_timestamp_twice) {
+  set_storage_topics({
+    {"topic", "test_msgs/BasicTypes", "rmw1_format"},
+    {"output_topic", "test_msgs/BasicTypes", "rmw2_format"}});
+  expect_messages({"topic", "output_topic"}, 20, 20);
+
+  EXPECT_CALL(*converter_factory_, load_deserializer("rmw1_format")).Times(2)
+  .WillRepeatedly(InvokeWithoutArgs(
+      []() -> std::unique_ptr<rosbag2::converter_interfaces::SerializationFormatDeserializer> {
+        return make_time_stamp_converter();
+      }));
+  EXPECT_CALL(*converter_factory_, load_serializer("rmw2_format")).Times(2)
+  .WillRepeatedly(InvokeWithoutArgs(
+      []() -> std::unique_ptr<rosbag2::converter_interfaces::SerializationFormatSerializer> {
+        return make_time_stamp_converter();
+      }));
+
+  rosbag2::StorageOptions storage_options;
+  storage_options.conversion_threads = 2;
+  reader_->open(storage_options, {"", "rmw2_format"});
+  std::vector<std::shared_ptr<rosbag2::SerializedBagMessage>> read_messages;
+  for (int i = 0; i < 3; ++i) {
+    read_messages.push_back(reader_->read_next());
+  }
+  reader_->set_filter(rosbag2::StorageFilter());
+  while (reader_->has_next()) {
+    read_messages.push_back(reader_->read_next());
+  }
+
+  // Messages of output_topic are passed through, so they are identical to the stored ones
+  ASSERT_THAT(read_messages, SizeIs(20));
+  for (size_t i = 1; i < read_messages.size(); i += 2) {
+    EXPECT_THAT(read_messages[i], Eq(stored_messages_[i]));
+  }
+}
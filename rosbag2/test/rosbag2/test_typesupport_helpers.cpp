@@ -109,3 +109,23 @@ TEST(TypesupportHelpersTest, returns_c_type_info_for_valid_library) {
   EXPECT_THAT(std::string(string_typesupport->typesupport_identifier),
     ContainsRegex("rosidl_typesupport"));
 }
+
+TEST(TypesupportHelpersTest, returns_cached_typesupport_for_repeated_requests) {
+  auto typesupport = rosbag2::get_typesupport("test_msgs/msg/BasicTypes", "rosidl_typesupport_cpp");
+
+  EXPECT_THAT(
+    rosbag2::get_typesupport("test_msgs/msg/BasicTypes", "rosidl_typesupport_cpp"),
+    Eq(typesupport));
+}
+
+TEST(TypesupportHelpersTest, preload_typesupports_loads_valid_types_and_ignores_invalid_ones) {
+  EXPECT_NO_THROW(
+    rosbag2::preload_typesupports(
+      {"test_msgs/msg/BasicTypes", "test_msgs/msg/Arrays", "invalid/message", "no_type"},
+      "rosidl_typesupport_cpp"));
+
+  EXPECT_THAT(
+    rosbag2::get_typesupport("test_msgs/msg/Arrays", "rosidl_typesupport_cpp"), NotNull());
+  EXPECT_THROW(
+    rosbag2::get_typesupport("invalid/message", "rosidl_typesupport_cpp"), std::runtime_error);
+}
@@ -15,6 +15,7 @@
 #include <gmock/gmock.h>
 
 #include <memory>
+#include <stdexcept>
 #include <string>
 #include <utility>
 #include <vector>
@@ -96,6 +97,19 @@ TEST_F(WriterTest, write_does_not_use_converters_if_input_and_output_format_are_
   writer_->write(message);
 }
 
+TEST_F(WriterTest, open_passes_write_batch_limits_and_index_creation_to_storage) {
+  storage_options_.write_batch_limits.max_messages = 10;
+  storage_options_.index_creation = rosbag2_storage::IndexCreation::AFTER_WRITING;
+  EXPECT_CALL(
+    *storage_,
+    set_write_batch_limits(Field(&rosbag2_storage::WriteBatchLimits::max_messages, 10u)));
+  EXPECT_CALL(*storage_, set_index_creation(rosbag2_storage::IndexCreation::AFTER_WRITING));
+  writer_ = std::make_unique<rosbag2::Writer>(
+    std::move(storage_factory_), converter_factory_, std::move(metadata_io_));
+
+  writer_->open(storage_options_, {"rmw_format", "rmw_format"});
+}
+
 TEST_F(WriterTest, metadata_io_writes_metadata_file_in_destructor) {
   EXPECT_CALL(*metadata_io_, write_metadata(_, _)).Times(1);
   writer_ = std::make_unique<rosbag2::Writer>(
@@ -122,3 +136,226 @@ TEST_F(WriterTest, open_throws_error_if_converter_plugin_does_not_exist) {
 
   EXPECT_ANY_THROW(writer_->open(storage_options_, {input_format, output_format}));
 }
+
+TEST_F(WriterTest, asynchronous_writes_are_flushed_to_storage_and_metadata_on_destruction) {
+  size_t written_messages = 0;
+  EXPECT_CALL(*storage_, write(_, _)).WillRepeatedly(
+    Invoke([&written_messages](
+      rosbag2::TopicId, std::shared_ptr<const rosbag2::SerializedBagMessage>) {
+      ++written_messages;
+    }));
+  rosbag2_storage::BagMetadata written_metadata;
+  EXPECT_CALL(*metadata_io_, write_metadata(_, _)).WillOnce(SaveArg<1>(&written_metadata));
+  writer_ = std::make_unique<rosbag2::Writer>(
+    std::move(storage_factory_), converter_factory_, std::move(metadata_io_));
+
+  std::string rmw_format = "rmw_format";
+  storage_options_.write_asynchronously = true;
+  storage_options_.write_queue_max_messages = 2;
+
+  writer_->open(storage_options_, {rmw_format, rmw_format});
+  writer_->create_topic({"test_topic", "test_msgs/BasicTypes", ""});
+  for (int i = 0; i < 10; ++i) {
+    auto message = std::make_shared<rosbag2::SerializedBagMessage>();
+    message->topic_name = "test_topic";
+    message->time_stamp = i;
+    writer_->write(message);
+  }
+  writer_.reset();
+
+  EXPECT_THAT(written_messages, Eq(10u));
+  EXPECT_THAT(written_metadata.message_count, Eq(10u));
+  ASSERT_THAT(written_metadata.topics_with_message_count, SizeIs(1));
+  EXPECT_THAT(written_metadata.topics_with_message_count[0].message_count, Eq(10u));
+}
+
+TEST_F(WriterTest, messages_written_by_topic_id_are_written_with_the_storage_topic_id) {
+  EXPECT_CALL(*storage_, create_topic(_)).WillOnce(Return(5)).WillOnce(Return(7));
+  EXPECT_CALL(*storage_, write(7, _)).Times(2);
+  rosbag2_storage::BagMetadata written_metadata;
+  EXPECT_CALL(*metadata_io_, write_metadata(_, _)).WillOnce(SaveArg<1>(&written_metadata));
+  writer_ = std::make_unique<rosbag2::Writer>(
+    std::move(storage_factory_), converter_factory_, std::move(metadata_io_));
+
+  std::string rmw_format = "rmw_format";
+  writer_->open(storage_options_, {rmw_format, rmw_format});
+  writer_->create_topic({"topic1", "test_msgs/BasicTypes", ""});
+  auto topic_id = writer_->create_topic({"topic2", "test_msgs/BasicTypes", ""});
+  EXPECT_THAT(writer_->create_topic({"topic2", "test_msgs/BasicTypes", ""}), Eq(topic_id));
+
+  writer_->write(topic_id, std::make_shared<rcutils_uint8_array_t>(), 1);
+  auto message = std::make_shared<rosbag2::SerializedBagMessage>();
+  message->topic_name = "topic2";
+  message->time_stamp = 2;
+  writer_->write(message);
+  EXPECT_ANY_THROW(writer_->write(topic_id + 1, std::make_shared<rcutils_uint8_array_t>(), 3));
+  writer_.reset();
+
+  ASSERT_THAT(written_metadata.topics_with_message_count, SizeIs(2));
+  EXPECT_THAT(written_metadata.topics_with_message_count[1].message_count, Eq(2u));
+  EXPECT_THAT(written_metadata.message_count, Eq(2u));
+}
+
+TEST_F(WriterTest, asynchronous_writes_are_converted_on_several_threads_and_stored_in_order) {
+  std::string input_format = "rmw1_format";
+  std::string storage_serialization_format = "rmw2_format";
+  EXPECT_CALL(*converter_factory_, load_deserializer(input_format)).Times(2)
+  .WillRepeatedly(InvokeWithoutArgs(
+      []() -> std::unique_ptr<rosbag2::converter_interfaces::SerializationFormatDeserializer> {
+        return make_time_stamp_converter();
+      }));
+  EXPECT_CALL(*converter_factory_, load_serializer(storage_serialization_format)).Times(2)
+  .WillRepeatedly(InvokeWithoutArgs(
+      []() -> std::unique_ptr<rosbag2::converter_interfaces::SerializationFormatSerializer> {
+        return make_time_stamp_converter();
+      }));
+  std::vector<rcutils_time_point_value_t> written_time_stamps;
+  EXPECT_CALL(*storage_, write(_, _)).WillRepeatedly(
+    Invoke([&written_time_stamps](
+      rosbag2::TopicId, std::shared_ptr<const rosbag2::SerializedBagMessage> message) {
+      written_time_stamps.push_back(message->time_stamp);
+    }));
+  writer_ = std::make_unique<rosbag2::Writer>(
+    std::move(storage_factory_), converter_factory_, std::move(metadata_io_));
+
+  storage_options_.write_asynchronously = true;
+  storage_options_.conversion_threads = 2;
+  writer_->open(storage_options_, {input_format, storage_serialization_format});
+  auto topic_id = writer_->create_topic({"test_topic", "test_msgs/BasicTypes", ""});
+  for (int i = 0; i < 100; ++i) {
+    writer_->write(topic_id, std::make_shared<rcutils_uint8_array_t>(), i);
+  }
+  writer_.reset();
+
+  ASSERT_THAT(written_time_stamps, SizeIs(100));
+  for (size_t i = 0; i < written_time_stamps.size(); ++i) {
+    EXPECT_THAT(written_time_stamps[i], Eq(static_cast<rcutils_time_point_value_t>(i)));
+  }
+}
+
+TEST_F(WriterTest, asynchronous_writes_are_converted_in_batches_and_stored_in_order) {
+  std::string input_format = "rmw1_format";
+  std::string storage_serialization_format = "rmw2_format";
+  EXPECT_CALL(*converter_factory_, load_deserializer(input_format))
+  .WillOnce(Return(ByMove(make_time_stamp_converter())));
+  EXPECT_CALL(*converter_factory_, load_serializer(storage_serialization_format))
+  .WillOnce(Return(ByMove(make_time_stamp_converter())));
+  std::vector<rcutils_time_point_value_t> written_time_stamps;
+  EXPECT_CALL(*storage_, write(_, _)).WillRepeatedly(
+    Invoke([&written_time_stamps](
+      rosbag2::TopicId, std::shared_ptr<const rosbag2::SerializedBagMessage> message) {
+      written_time_stamps.push_back(message->time_stamp);
+    }));
+  writer_ = std::make_unique<rosbag2::Writer>(
+    std::move(storage_factory_), converter_factory_, std::move(metadata_io_));
+
+  storage_options_.write_asynchronously = true;
+  writer_->open(storage_options_, {input_format, storage_serialization_format});
+  writer_->create_topic({"topic1", "test_msgs/BasicTypes", ""});
+  writer_->create_topic({"topic2", "test_msgs/Strings", ""});
+  // The converter converts the messages of each topic together and restores their order
+  for (int i = 0; i < 10; ++i) {
+    auto message = std::make_shared<rosbag2::SerializedBagMessage>();
+    message->topic_name = i % 3 == 0 ? "topic1" : "topic2";
+    message->time_stamp = i;
+    writer_->write(message);
+  }
+  writer_.reset();
+
+  EXPECT_THAT(written_time_stamps, ElementsAre(0, 1, 2, 3, 4, 5, 6, 7, 8, 9));
+}
+
+TEST_F(WriterTest, messages_failing_conversion_on_several_threads_are_not_counted) {
+  std::string input_format = "rmw1_format";
+  std::string storage_serialization_format = "rmw2_format";
+  EXPECT_CALL(*converter_factory_, load_deserializer(input_format)).Times(2)
+  .WillRepeatedly(InvokeWithoutArgs(
+      []() -> std::unique_ptr<rosbag2::converter_interfaces::SerializationFormatDeserializer> {
+        auto deserializer = make_time_stamp_converter();
+        ON_CALL(*deserializer, deserialize(_, _, _)).WillByDefault(
+          Invoke([](
+            std::shared_ptr<const rosbag2::SerializedBagMessage> message,
+            const rosidl_message_type_support_t *,
+            std::shared_ptr<rosbag2_introspection_message_t> ros_message) {
+            if (message->time_stamp == 4) {
+              throw std::runtime_error("conversion failed");
+            }
+            ros_message->time_stamp = message->time_stamp;
+          }));
+        return deserializer;
+      }));
+  EXPECT_CALL(*converter_factory_, load_serializer(storage_serialization_format)).Times(2)
+  .WillRepeatedly(InvokeWithoutArgs(
+      []() -> std::unique_ptr<rosbag2::converter_interfaces::SerializationFormatSerializer> {
+        return make_time_stamp_converter();
+      }));
+  size_t written_messages = 0;
+  EXPECT_CALL(*storage_, write(_, _)).WillRepeatedly(
+    Invoke([&written_messages](
+      rosbag2::TopicId, std::shared_ptr<const rosbag2::SerializedBagMessage>) {
+      ++written_messages;
+    }));
+  rosbag2_storage::BagMetadata written_metadata;
+  EXPECT_CALL(*metadata_io_, write_metadata(_, _)).WillOnce(SaveArg<1>(&written_metadata));
+  writer_ = std::make_unique<rosbag2::Writer>(
+    std::move(storage_factory_), converter_factory_, std::move(metadata_io_));
+
+  storage_options_.write_asynchronously = true;
+  storage_options_.conversion_threads = 2;
+  writer_->open(storage_options_, {input_format, storage_serialization_format});
+  auto topic_id = writer_->create_topic({"test_topic", "test_msgs/BasicTypes", ""});
+  for (int i = 0; i < 10; ++i) {
+    writer_->write(topic_id, std::make_shared<rcutils_uint8_array_t>(), i);
+  }
+  writer_.reset();
+
+  EXPECT_THAT(written_messages, Eq(9u));
+  EXPECT_THAT(written_metadata.message_count, Eq(9u));
+}
+
+TEST_F(WriterTest, failing_conversion_in_a_batch_only_loses_the_failing_message) {
+  std::string input_format = "rmw1_format";
+  std::string storage_serialization_format = "rmw2_format";
+  auto deserializer = make_time_stamp_converter();
+  auto time_stamp_deserialize = [](
+    std::shared_ptr<const rosbag2::SerializedBagMessage> message,
+    const rosidl_message_type_support_t *,
+    std::shared_ptr<rosbag2_introspection_message_t> ros_message) {
+      if (message->time_stamp == 4) {
+        throw std::runtime_error("conversion failed");
+      }
+      ros_message->time_stamp = message->time_stamp;
+    };
+  ON_CALL(*deserializer, deserialize(_, _, _)).WillByDefault(Invoke(time_stamp_deserialize));
+  EXPECT_CALL(*converter_factory_, load_deserializer(input_format))
+  .WillOnce(Return(ByMove(std::move(deserializer))));
+  EXPECT_CALL(*converter_factory_, load_serializer(storage_serialization_format))
+  .WillOnce(Return(ByMove(make_time_stamp_converter())));
+  std::vector<rcutils_time_point_value_t> written_time_stamps;
+  EXPECT_CALL(*storage_, write(_, _)).WillRepeatedly(
+    Invoke([&written_time_stamps](
+      rosbag2::TopicId, std::shared_ptr<const rosbag2::SerializedBagMessage> message) {
+      written_time_stamps.push_back(message->time_stamp);
+    }));
+  rosbag2_storage::BagMetadata written_metadata;
+  EXPECT_CALL(*metadata_io_, write_metadata(_, _)).WillOnce(SaveArg<1>(&written_metadata));
+  writer_ = std::make_unique<rosbag2::Writer>(
+    std::move(storage_factory_), converter_factory_, std::move(metadata_io_));
+
+  storage_options_.write_asynchronously = true;
+  writer_->open(storage_options_, {input_format, storage_serialization_format});
+  writer_->create_topic({"topic1", "test_msgs/BasicTypes", ""});
+  writer_->create_topic({"topic2", "test_msgs/Strings", ""});
+  for (int i = 0; i < 10; ++i) {
+    auto message = std::make_shared<rosbag2::SerializedBagMessage>();
+    message->topic_name = i % 3 == 0 ? "topic1" : "topic2";
+    message->time_stamp = i;
+    writer_->write(message);
+  }
+  writer_.reset();
+
+  EXPECT_THAT(written_time_stamps, ElementsAre(0, 1, 2, 3, 5, 6, 7, 8, 9));
+  EXPECT_THAT(written_metadata.message_count, Eq(9u));
+  ASSERT_THAT(written_metadata.topics_with_message_count, SizeIs(2));
+  EXPECT_THAT(written_metadata.topics_with_message_count[1].message_count, Eq(5u));
+}
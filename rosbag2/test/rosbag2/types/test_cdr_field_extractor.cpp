@@ -0,0 +1,218 @@
+// Copyright 2018, Bosch Software Innovations GmbH.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gmock/gmock.h>
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "rosbag2/types/cdr_field_extractor.hpp"
+#include "rosidl_typesupport_introspection_cpp/field_types.hpp"
+
+using namespace testing;  // NOLINT
+using rosidl_typesupport_introspection_cpp::MessageMember;
+using rosidl_typesupport_introspection_cpp::MessageMembers;
+
+namespace
+{
+
+MessageMember make_member(
+  const char * name, uint8_t type_id, const rosidl_message_type_support_t * members = nullptr,
+  bool is_array = false, size_t array_size = 0, bool is_upper_bound = false)
+{
+  return {name, type_id, 0, members, is_array, array_size, is_upper_bound, 0, nullptr,
+    nullptr, nullptr, nullptr, nullptr};
+}
+
+// Writes CDR like Fast CDR does, aligning primitives to their size relative to the data start
+class CdrWriter
+{
+public:
+  explicit CdrWriter(bool is_big_endian = false)
+  : is_big_endian_(is_big_endian), buffer_({0, static_cast<uint8_t>(is_big_endian ? 0 : 1), 0, 0})
+  {}
+
+  template<typename T>
+  CdrWriter & write(T value)
+  {
+    align(std::min<size_t>(sizeof(T), 8));
+    uint8_t bytes[sizeof(T)];
+    std::memcpy(bytes, &value, sizeof(T));
+    if (is_big_endian_) {
+      std::reverse(bytes, bytes + sizeof(T));
+    }
+    buffer_.insert(buffer_.end(), bytes, bytes + sizeof(T));
+    return *this;
+  }
+
+  CdrWriter & write_string(const std::string & value)
+  {
+    write<uint32_t>(static_cast<uint32_t>(value.size() + 1));
+    buffer_.insert(buffer_.end(), value.begin(), value.end());
+    buffer_.push_back(0);
+    return *this;
+  }
+
+  rcutils_uint8_array_t get_message()
+  {
+    rcutils_uint8_array_t message;
+    message.buffer = buffer_.data();
+    message.buffer_length = buffer_.size();
+    message.buffer_capacity = buffer_.size();
+    message.allocator = rcutils_get_default_allocator();
+    return message;
+  }
+
+private:
+  void align(size_t alignment)
+  {
+    while ((buffer_.size() - 4) % alignment != 0) {
+      buffer_.push_back(0xff);
+    }
+  }
+
+  bool is_big_endian_;
+  std::vector<uint8_t> buffer_;
+};
+
+}  // namespace
+
+class CdrFieldExtractorTest : public Test
+{
+public:
+  CdrFieldExtractorTest()
+  {
+    namespace ts = rosidl_typesupport_introspection_cpp;
+    time_fields_ = {make_member("sec", ts::ROS_TYPE_INT32),
+      make_member("nanosec", ts::ROS_TYPE_UINT32)};
+    time_members_ = {"builtin_interfaces::msg", "Time", 2, 8, time_fields_.data(), nullptr,
+      nullptr};
+    time_type_support_ = {"rosidl_typesupport_introspection_cpp", &time_members_, nullptr};
+
+    header_fields_ = {make_member("stamp", ts::ROS_TYPE_MESSAGE, &time_type_support_),
+      make_member("frame_id", ts::ROS_TYPE_STRING)};
+    header_members_ = {"std_msgs::msg", "Header", 2, 40, header_fields_.data(), nullptr, nullptr};
+    header_type_support_ = {"rosidl_typesupport_introspection_cpp", &header_members_, nullptr};
+
+    sample_fields_ = {
+      make_member("flag", ts::ROS_TYPE_BOOLEAN),
+      make_member("header", ts::ROS_TYPE_MESSAGE, &header_type_support_),
+      make_member("values", ts::ROS_TYPE_DOUBLE, nullptr, true),
+      make_member("count", ts::ROS_TYPE_UINT16),
+      make_member("names", ts::ROS_TYPE_STRING, nullptr, true, 2),
+      make_member("ratio", ts::ROS_TYPE_DOUBLE),
+      make_member("stamps", ts::ROS_TYPE_MESSAGE, &time_type_support_, true, 3, true),
+      make_member("last", ts::ROS_TYPE_INT8)};
+    sample_members_ = {"test_msgs::msg", "Sample", 8, 200, sample_fields_.data(), nullptr,
+      nullptr};
+    sample_type_support_ = {"rosidl_typesupport_introspection_cpp", &sample_members_, nullptr};
+  }
+
+  // Serializes a Sample with the given values and names
+  CdrWriter & write_sample(
+    CdrWriter & writer, const std::vector<double> & values, const std::string & frame_id)
+  {
+    writer.write<uint8_t>(1).write<int32_t>(-3).write<uint32_t>(500).write_string(frame_id);
+    writer.write<uint32_t>(static_cast<uint32_t>(values.size()));
+    for (auto value : values) {
+      writer.write(value);
+    }
+    writer.write<uint16_t>(7).write_string("a").write_string("bcd").write(0.25);
+    writer.write<uint32_t>(2).write<int32_t>(1).write<uint32_t>(2).write<int32_t>(3);
+    writer.write<uint32_t>(4).write<int8_t>(-9);
+    return writer;
+  }
+
+  std::unique_ptr<rosbag2::CdrFieldExtractor> make_extractor(const std::string & field_path)
+  {
+    return std::make_unique<rosbag2::CdrFieldExtractor>(&sample_type_support_, field_path);
+  }
+
+  std::vector<MessageMember> time_fields_;
+  MessageMembers time_members_;
+  rosidl_message_type_support_t time_type_support_;
+  std::vector<MessageMember> header_fields_;
+  MessageMembers header_members_;
+  rosidl_message_type_support_t header_type_support_;
+  std::vector<MessageMember> sample_fields_;
+  MessageMembers sample_members_;
+  rosidl_message_type_support_t sample_type_support_;
+};
+
+TEST_F(CdrFieldExtractorTest, fields_in_front_of_strings_and_sequences_have_fixed_offsets) {
+  EXPECT_TRUE(make_extractor("flag")->has_fixed_offset());
+  EXPECT_TRUE(make_extractor("header.stamp")->has_fixed_offset());
+  EXPECT_TRUE(make_extractor("header.stamp.nanosec")->has_fixed_offset());
+  EXPECT_TRUE(make_extractor("header.frame_id")->has_fixed_offset());
+  EXPECT_FALSE(make_extractor("count")->has_fixed_offset());
+  EXPECT_FALSE(make_extractor("last")->has_fixed_offset());
+}
+
+TEST_F(CdrFieldExtractorTest, fields_are_read_from_the_serialized_message) {
+  CdrWriter writer;
+  auto message = write_sample(writer, {1.5, 2.5}, "frame").get_message();
+
+  EXPECT_THAT(make_extractor("flag")->read_integer(message), Eq(1));
+  EXPECT_THAT(
+    make_extractor("header.stamp")->read_time_point(message), Eq(-3 * 1000000000LL + 500));
+  EXPECT_THAT(make_extractor("header.stamp.sec")->read_integer(message), Eq(-3));
+  EXPECT_THAT(make_extractor("header.frame_id")->read_string(message), StrEq("frame"));
+  EXPECT_THAT(make_extractor("count")->read_integer(message), Eq(7));
+  EXPECT_THAT(make_extractor("ratio")->read_floating_point(message), Eq(0.25));
+  EXPECT_THAT(make_extractor("last")->read_integer(message), Eq(-9));
+}
+
+TEST_F(CdrFieldExtractorTest, empty_sequences_are_not_aligned) {
+  CdrWriter writer;
+  auto message = write_sample(writer, {}, "frame_id").get_message();
+
+  EXPECT_THAT(make_extractor("count")->read_integer(message), Eq(7));
+  EXPECT_THAT(make_extractor("ratio")->read_floating_point(message), Eq(0.25));
+  EXPECT_THAT(make_extractor("last")->read_integer(message), Eq(-9));
+}
+
+TEST_F(CdrFieldExtractorTest, big_endian_messages_are_read) {
+  CdrWriter writer(true);
+  auto message = write_sample(writer, {1.5}, "frame").get_message();
+
+  EXPECT_THAT(
+    make_extractor("header.stamp")->read_time_point(message), Eq(-3 * 1000000000LL + 500));
+  EXPECT_THAT(make_extractor("count")->read_integer(message), Eq(7));
+  EXPECT_THAT(make_extractor("ratio")->read_floating_point(message), Eq(0.25));
+}
+
+TEST_F(CdrFieldExtractorTest, constructor_throws_for_fields_which_cannot_be_extracted) {
+  EXPECT_THROW(make_extractor("unknown"), std::runtime_error);
+  EXPECT_THROW(make_extractor("header.unknown"), std::runtime_error);
+  EXPECT_THROW(make_extractor("header"), std::runtime_error);
+  EXPECT_THROW(make_extractor("values"), std::runtime_error);
+  EXPECT_THROW(make_extractor("flag.value"), std::runtime_error);
+  EXPECT_THROW(make_extractor(""), std::runtime_error);
+}
+
+TEST_F(CdrFieldExtractorTest, reading_throws_for_wrong_types_and_truncated_messages) {
+  CdrWriter writer;
+  auto message = write_sample(writer, {1.5, 2.5}, "frame").get_message();
+
+  EXPECT_THROW(make_extractor("count")->read_string(message), std::runtime_error);
+  EXPECT_THROW(make_extractor("header.frame_id")->read_integer(message), std::runtime_error);
+
+  message.buffer_length = 20;
+  EXPECT_THROW(make_extractor("last")->read_integer(message), std::runtime_error);
+  EXPECT_THROW(make_extractor("header.frame_id")->read_string(message), std::runtime_error);
+}
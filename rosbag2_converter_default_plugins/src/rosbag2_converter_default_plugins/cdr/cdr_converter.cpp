@@ -16,6 +16,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "ament_index_cpp/get_resources.hpp"
 #include "ament_index_cpp/get_package_prefix.hpp"
@@ -100,27 +101,69 @@ void CdrConverter::deserialize(
   const rosidl_message_type_support_t * type_support,
   std::shared_ptr<rosbag2_introspection_message_t> introspection_message)
 {
-  rosbag2::introspection_message_set_topic_name(
-    introspection_message.get(), serialized_message->topic_name.c_str());
-  introspection_message->time_stamp = serialized_message->time_stamp;
+  deserialize_message(*serialized_message, type_support, *introspection_message);
+}
+
+void CdrConverter::serialize(
+  const std::shared_ptr<const rosbag2_introspection_message_t> introspection_message,
+  const rosidl_message_type_support_t * type_support,
+  std::shared_ptr<rosbag2::SerializedBagMessage> serialized_message)
+{
+  serialize_message(*introspection_message, type_support, *serialized_message);
+}
+
+void CdrConverter::deserialize_batch(
+  const std::vector<std::shared_ptr<const rosbag2::SerializedBagMessage>> & serialized_messages,
+  const rosidl_message_type_support_t * type_support,
+  const std::vector<std::shared_ptr<rosbag2_introspection_message_t>> & introspection_messages)
+{
+  for (size_t i = 0; i < serialized_messages.size(); ++i) {
+    deserialize_message(*serialized_messages[i], type_support, *introspection_messages[i]);
+  }
+}
+
+void CdrConverter::serialize_batch(
+  const std::vector<std::shared_ptr<const rosbag2_introspection_message_t>> &
+  introspection_messages,
+  const rosidl_message_type_support_t * type_support,
+  const std::vector<std::shared_ptr<rosbag2::SerializedBagMessage>> & serialized_messages)
+{
+  for (size_t i = 0; i < introspection_messages.size(); ++i) {
+    serialize_message(*introspection_messages[i], type_support, *serialized_messages[i]);
+  }
+}
+
+void CdrConverter::deserialize_message(
+  const rosbag2::SerializedBagMessage & serialized_message,
+  const rosidl_message_type_support_t * type_support,
+  rosbag2_introspection_message_t & introspection_message)
+{
+  // Reused messages mostly keep their topic, which then does not need to be copied again
+  if (!introspection_message.topic_name ||
+    serialized_message.topic_name != introspection_message.topic_name)
+  {
+    rosbag2::introspection_message_set_topic_name(
+      &introspection_message, serialized_message.topic_name.c_str());
+  }
+  introspection_message.time_stamp = serialized_message.time_stamp;
 
   auto ret = deserialize_fcn_(
-    serialized_message->serialized_data.get(), type_support, introspection_message->message);
+    serialized_message.serialized_data.get(), type_support, introspection_message.message);
   if (ret != RMW_RET_OK) {
     ROSBAG2_CONVERTER_DEFAULT_PLUGINS_LOG_ERROR("Failed to deserialize message.");
   }
 }
 
-void CdrConverter::serialize(
-  const std::shared_ptr<const rosbag2_introspection_message_t> introspection_message,
+void CdrConverter::serialize_message(
+  const rosbag2_introspection_message_t & introspection_message,
   const rosidl_message_type_support_t * type_support,
-  std::shared_ptr<rosbag2::SerializedBagMessage> serialized_message)
+  rosbag2::SerializedBagMessage & serialized_message)
 {
-  serialized_message->topic_name = std::string(introspection_message->topic_name);
-  serialized_message->time_stamp = introspection_message->time_stamp;
+  serialized_message.topic_name = introspection_message.topic_name;
+  serialized_message.time_stamp = introspection_message.time_stamp;
 
   auto ret = serialize_fcn_(
-    introspection_message->message, type_support, serialized_message->serialized_data.get());
+    introspection_message.message, type_support, serialized_message.serialized_data.get());
   if (ret != RMW_RET_OK) {
     ROSBAG2_CONVERTER_DEFAULT_PLUGINS_LOG_ERROR("Failed to serialize message.");
   }
@@ -17,6 +17,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "rmw/types.h"
 
@@ -42,7 +43,30 @@ public:
     const rosidl_message_type_support_t * type_support,
     std::shared_ptr<rosbag2::SerializedBagMessage> serialized_message) override;
 
+  void deserialize_batch(
+    const std::vector<std::shared_ptr<const rosbag2::SerializedBagMessage>> & serialized_messages,
+    const rosidl_message_type_support_t * type_support,
+    const std::vector<std::shared_ptr<rosbag2_introspection_message_t>> & introspection_messages)
+  override;
+
+  void serialize_batch(
+    const std::vector<std::shared_ptr<const rosbag2_introspection_message_t>> &
+    introspection_messages,
+    const rosidl_message_type_support_t * type_support,
+    const std::vector<std::shared_ptr<rosbag2::SerializedBagMessage>> & serialized_messages)
+  override;
+
 protected:
+  void deserialize_message(
+    const rosbag2::SerializedBagMessage & serialized_message,
+    const rosidl_message_type_support_t * type_support,
+    rosbag2_introspection_message_t & introspection_message);
+
+  void serialize_message(
+    const rosbag2_introspection_message_t & introspection_message,
+    const rosidl_message_type_support_t * type_support,
+    rosbag2::SerializedBagMessage & serialized_message);
+
   rmw_ret_t (* serialize_fcn_)(
     const void *,
     const rosidl_message_type_support_t *,
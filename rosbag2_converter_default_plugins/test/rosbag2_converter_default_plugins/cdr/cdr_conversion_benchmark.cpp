@@ -0,0 +1,118 @@
+// Copyright 2018, Bosch Software Innovations GmbH.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Measures the throughput of converting CDR messages into CDR through ROS messages, once
+// allocating a ROS message and an empty output buffer per message as a baseline and once with
+// rosbag2::Converter, which reuses them per topic.
+//
+// Usage: cdr_conversion_benchmark [number_of_messages]
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include "../../../src/rosbag2_converter_default_plugins/cdr/cdr_converter.hpp"
+#include "rosbag2/converter.hpp"
+#include "rosbag2/serialization_format_converter_factory_interface.hpp"
+#include "rosbag2/typesupport_helpers.hpp"
+#include "rosbag2/types/introspection_message.hpp"
+#include "rosbag2_test_common/memory_management.hpp"
+#include "test_msgs/message_fixtures.hpp"
+
+using rosbag2_converter_default_plugins::CdrConverter;
+
+namespace
+{
+
+// Hands out the CDR converter without going through pluginlib
+class CdrConverterFactory : public rosbag2::SerializationFormatConverterFactoryInterface
+{
+public:
+  std::unique_ptr<rosbag2::converter_interfaces::SerializationFormatDeserializer>
+  load_deserializer(const std::string &) override
+  {
+    return std::make_unique<CdrConverter>();
+  }
+
+  std::unique_ptr<rosbag2::converter_interfaces::SerializationFormatSerializer>
+  load_serializer(const std::string &) override
+  {
+    return std::make_unique<CdrConverter>();
+  }
+};
+
+template<typename Function>
+double measure_messages_per_second(size_t number_of_messages, Function convert)
+{
+  auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < number_of_messages; ++i) {
+    convert();
+  }
+  std::chrono::duration<double> duration = std::chrono::steady_clock::now() - start;
+  return number_of_messages / duration.count();
+}
+
+template<typename T>
+void run_benchmark(const std::string & type, std::shared_ptr<T> message, size_t number_of_messages)
+{
+  rosbag2_test_common::MemoryManagement memory_management;
+  auto bag_message = std::make_shared<rosbag2::SerializedBagMessage>();
+  bag_message->serialized_data = memory_management.serialize_message(message);
+  bag_message->topic_name = "/benchmark";
+  bag_message->time_stamp = 0;
+
+  CdrConverter cdr_converter;
+  auto type_support = rosbag2::get_typesupport(type, "rosidl_typesupport_cpp");
+  auto introspection_type_support =
+    rosbag2::get_typesupport(type, "rosidl_typesupport_introspection_cpp");
+  auto allocator = rcutils_get_default_allocator();
+  auto convert_allocating_per_message = [&]() {
+      auto ros_message =
+        rosbag2::allocate_introspection_message(introspection_type_support, &allocator);
+      cdr_converter.deserialize(bag_message, type_support, ros_message);
+      auto output_message = std::make_shared<rosbag2::SerializedBagMessage>();
+      output_message->serialized_data = memory_management.make_initialized_message();
+      cdr_converter.serialize(ros_message, type_support, output_message);
+    };
+  auto per_message_rate =
+    measure_messages_per_second(number_of_messages, convert_allocating_per_message);
+
+  rosbag2::Converter converter("cdr", "cdr", std::make_shared<CdrConverterFactory>());
+  converter.add_topic(bag_message->topic_name, type);
+  auto convert_reusing_per_topic = [&]() {
+      converter.convert(bag_message);
+    };
+  auto pooled_rate = measure_messages_per_second(number_of_messages, convert_reusing_per_topic);
+
+  std::cout << type << " (" << bag_message->serialized_data->buffer_length << " bytes): " <<
+    static_cast<uint64_t>(per_message_rate) << " messages/s allocating per message, " <<
+    static_cast<uint64_t>(pooled_rate) << " messages/s reusing per topic" << std::endl;
+}
+
+}  // namespace
+
+int main(int argc, char ** argv)
+{
+  size_t number_of_messages = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 100000;
+
+  run_benchmark("test_msgs/BasicTypes", get_messages_basic_types()[1], number_of_messages);
+  run_benchmark("test_msgs/Strings", get_messages_strings()[2], number_of_messages);
+  run_benchmark(
+    "test_msgs/UnboundedSequences", get_messages_unbounded_sequences()[1], number_of_messages);
+  run_benchmark("test_msgs/MultiNested", get_messages_multi_nested()[0], number_of_messages);
+
+  return 0;
+}
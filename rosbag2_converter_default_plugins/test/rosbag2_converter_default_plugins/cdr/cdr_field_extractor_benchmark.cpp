@@ -0,0 +1,131 @@
+// Copyright 2018, Bosch Software Innovations GmbH.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Measures the throughput of reading a single integer field of CDR messages, once by
+// deserializing the whole message as a baseline and once with rosbag2::CdrFieldExtractor.
+//
+// Usage: cdr_field_extractor_benchmark [number_of_messages]
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#include "../../../src/rosbag2_converter_default_plugins/cdr/cdr_converter.hpp"
+#include "rosbag2/typesupport_helpers.hpp"
+#include "rosbag2/types/cdr_field_extractor.hpp"
+#include "rosbag2/types/introspection_message.hpp"
+#include "rosbag2_test_common/memory_management.hpp"
+#include "rosidl_typesupport_introspection_cpp/message_introspection.hpp"
+#include "test_msgs/message_fixtures.hpp"
+
+using rosbag2_converter_default_plugins::CdrConverter;
+
+namespace
+{
+
+template<typename Function>
+double measure_messages_per_second(size_t number_of_messages, Function read_field)
+{
+  int64_t checksum = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < number_of_messages; ++i) {
+    checksum += read_field();
+  }
+  std::chrono::duration<double> duration = std::chrono::steady_clock::now() - start;
+  // Keeps the reads from being optimized away
+  if (checksum == 42) {
+    std::cout << std::flush;
+  }
+  return number_of_messages / duration.count();
+}
+
+template<typename FieldType>
+FieldType read_member(
+  const rosbag2_introspection_message_t & ros_message,
+  const rosidl_message_type_support_t * introspection_type_support,
+  const std::string & field_name)
+{
+  auto members = static_cast<const rosidl_typesupport_introspection_cpp::MessageMembers *>(
+    introspection_type_support->data);
+  for (uint32_t i = 0; i < members->member_count_; ++i) {
+    if (field_name == members->members_[i].name_) {
+      FieldType value;
+      std::memcpy(
+        &value, static_cast<const uint8_t *>(ros_message.message) + members->members_[i].offset_,
+        sizeof(value));
+      return value;
+    }
+  }
+  throw std::runtime_error("No field " + field_name);
+}
+
+template<typename FieldType, typename T>
+void run_benchmark(
+  const std::string & type, std::shared_ptr<T> message, const std::string & field_name,
+  size_t number_of_messages)
+{
+  rosbag2_test_common::MemoryManagement memory_management;
+  auto bag_message = std::make_shared<rosbag2::SerializedBagMessage>();
+  bag_message->serialized_data = memory_management.serialize_message(message);
+  bag_message->topic_name = "/benchmark";
+  bag_message->time_stamp = 0;
+
+  CdrConverter cdr_converter;
+  auto type_support = rosbag2::get_typesupport(type, "rosidl_typesupport_cpp");
+  auto introspection_type_support =
+    rosbag2::get_typesupport(type, "rosidl_typesupport_introspection_cpp");
+  auto allocator = rcutils_get_default_allocator();
+  auto ros_message =
+    rosbag2::allocate_introspection_message(introspection_type_support, &allocator);
+  auto read_deserializing = [&]() -> int64_t {
+      cdr_converter.deserialize(bag_message, type_support, ros_message);
+      return read_member<FieldType>(*ros_message, introspection_type_support, field_name);
+    };
+  auto deserializing_rate = measure_messages_per_second(number_of_messages, read_deserializing);
+
+  rosbag2::CdrFieldExtractor extractor(introspection_type_support, field_name);
+  auto read_extracting = [&]() -> int64_t {
+      return extractor.read_integer(*bag_message->serialized_data);
+    };
+  auto extracting_rate = measure_messages_per_second(number_of_messages, read_extracting);
+
+  if (read_deserializing() != read_extracting()) {
+    throw std::runtime_error("Extracted " + field_name + " differs from the deserialized one.");
+  }
+
+  std::cout << type << "." << field_name << " (" <<
+    bag_message->serialized_data->buffer_length << " bytes, " <<
+    (extractor.has_fixed_offset() ? "fixed" : "variable") << " offset): " <<
+    static_cast<uint64_t>(deserializing_rate) << " messages/s deserializing, " <<
+    static_cast<uint64_t>(extracting_rate) << " messages/s extracting" << std::endl;
+}
+
+}  // namespace
+
+int main(int argc, char ** argv)
+{
+  size_t number_of_messages = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 100000;
+
+  run_benchmark<uint64_t>(
+    "test_msgs/BasicTypes", get_messages_basic_types()[1], "uint64_value", number_of_messages);
+  run_benchmark<int32_t>(
+    "test_msgs/UnboundedSequences", get_messages_unbounded_sequences()[1], "alignment_check",
+    number_of_messages);
+
+  return 0;
+}
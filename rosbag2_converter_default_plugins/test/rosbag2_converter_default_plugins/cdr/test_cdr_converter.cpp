@@ -16,6 +16,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "../../../src/rosbag2_converter_default_plugins/cdr/cdr_converter.hpp"
 #include "../../../src/rosbag2_converter_default_plugins/logging.hpp"
@@ -308,3 +309,50 @@ TEST_F(CdrConverterTestFixture, serialize_converts_ros_message_into_cdr_for_mult
   EXPECT_THAT(serialized_message->topic_name, StrEq(topic_name_));
   EXPECT_THAT(serialized_message->time_stamp, Eq(ros_message->time_stamp));
 }
+
+TEST_F(CdrConverterTestFixture, batches_of_messages_are_converted_in_order) {
+  auto messages = get_messages_strings();
+  auto type_support = rosbag2::get_typesupport("test_msgs/Strings", "rosidl_typesupport_cpp");
+
+  std::vector<std::shared_ptr<const rosbag2::SerializedBagMessage>> serialized_messages;
+  std::vector<std::shared_ptr<rosbag2_introspection_message_t>> ros_messages;
+  std::vector<test_msgs::msg::Strings> string_test_msgs(messages.size());
+  for (size_t i = 0; i < messages.size(); ++i) {
+    auto serialized_message = std::make_shared<rosbag2::SerializedBagMessage>();
+    serialized_message->serialized_data = memory_management_->serialize_message(messages[i]);
+    serialized_message->topic_name = topic_name_;
+    serialized_message->time_stamp = i;
+    serialized_messages.push_back(serialized_message);
+
+    auto ros_message = make_shared_ros_message();
+    ros_message->message = &string_test_msgs[i];
+    ros_messages.push_back(ros_message);
+  }
+
+  converter_->deserialize_batch(serialized_messages, type_support, ros_messages);
+
+  std::vector<std::shared_ptr<rosbag2::SerializedBagMessage>> reserialized_messages;
+  for (size_t i = 0; i < messages.size(); ++i) {
+    EXPECT_THAT(string_test_msgs[i], Eq(*messages[i]));
+    EXPECT_THAT(ros_messages[i]->time_stamp, Eq(static_cast<rcutils_time_point_value_t>(i)));
+    EXPECT_THAT(ros_messages[i]->topic_name, StrEq(topic_name_));
+
+    auto reserialized_message = std::make_shared<rosbag2::SerializedBagMessage>();
+    reserialized_message->serialized_data = memory_management_->make_initialized_message();
+    reserialized_messages.push_back(reserialized_message);
+  }
+
+  converter_->serialize_batch(
+    std::vector<std::shared_ptr<const rosbag2_introspection_message_t>>(
+      ros_messages.begin(), ros_messages.end()),
+    type_support, reserialized_messages);
+
+  for (size_t i = 0; i < messages.size(); ++i) {
+    auto deserialized_msg = memory_management_->deserialize_message<test_msgs::msg::Strings>(
+      reserialized_messages[i]->serialized_data);
+    EXPECT_THAT(*deserialized_msg, Eq(*messages[i]));
+    EXPECT_THAT(reserialized_messages[i]->topic_name, StrEq(topic_name_));
+    EXPECT_THAT(
+      reserialized_messages[i]->time_stamp, Eq(static_cast<rcutils_time_point_value_t>(i)));
+  }
+}
@@ -0,0 +1,38 @@
+// Copyright 2018 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROSBAG2_STORAGE__HUGE_PAGE_ALLOCATOR_HPP_
+#define ROSBAG2_STORAGE__HUGE_PAGE_ALLOCATOR_HPP_
+
+#include "rcutils/allocator.h"
+
+#include "rosbag2_storage/visibility_control.hpp"
+
+namespace rosbag2_storage
+{
+
+/**
+ * Get an allocator which backs blocks of at least one huge page (2 MiB) by separate memory
+ * mappings aligned to huge pages, and advises the kernel to use transparent huge pages for them.
+ * This saves page faults and TLB misses when handling large messages, and such blocks are
+ * returned to the system once freed instead of fragmenting the heap.
+ *
+ * Smaller blocks, and all blocks on systems other than Linux, are taken from the heap.
+ */
+ROSBAG2_STORAGE_PUBLIC
+rcutils_allocator_t get_huge_page_allocator();
+
+}  // namespace rosbag2_storage
+
+#endif  // ROSBAG2_STORAGE__HUGE_PAGE_ALLOCATOR_HPP_
@@ -0,0 +1,35 @@
+// Copyright 2018, Bosch Software Innovations GmbH.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROSBAG2_STORAGE__INDEX_CREATION_HPP_
+#define ROSBAG2_STORAGE__INDEX_CREATION_HPP_
+
+namespace rosbag2_storage
+{
+
+/**
+ * Point in time at which a storage creates the indices serving reads. Creating them after writing
+ * spares their maintenance on every written message, at the price of a longer closing of the
+ * storage. A bag whose recording was interrupted before then has no indices, so that every read
+ * of it scans and sorts all messages.
+ */
+enum class IndexCreation
+{
+  BEFORE_WRITING,
+  AFTER_WRITING
+};
+
+}  // namespace rosbag2_storage
+
+#endif  // ROSBAG2_STORAGE__INDEX_CREATION_HPP_
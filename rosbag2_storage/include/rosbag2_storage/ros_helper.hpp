@@ -17,6 +17,7 @@
 
 #include <memory>
 
+#include "rcutils/allocator.h"
 #include "rcutils/types/uint8_array.h"
 
 #include "rosbag2_storage/visibility_control.hpp"
@@ -24,14 +25,20 @@
 namespace rosbag2_storage
 {
 
+/**
+ * Create a serialized message holding a copy of the given data. The message buffer is allocated
+ * with the given allocator, which is also used to resize and to free it.
+ */
 ROSBAG2_STORAGE_PUBLIC
 std::shared_ptr<rcutils_uint8_array_t>
-make_serialized_message(const void * data, size_t size);
+make_serialized_message(
+  const void * data, size_t size,
+  rcutils_allocator_t allocator = rcutils_get_default_allocator());
 
 ROSBAG2_STORAGE_PUBLIC
 std::shared_ptr<rcutils_uint8_array_t>
-make_empty_serialized_message(size_t size);
-
+make_empty_serialized_message(
+  size_t size, rcutils_allocator_t allocator = rcutils_get_default_allocator());
 
 }  // namespace rosbag2_storage
 
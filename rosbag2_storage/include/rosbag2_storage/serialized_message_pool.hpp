@@ -0,0 +1,101 @@
+// Copyright 2018 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROSBAG2_STORAGE__SERIALIZED_MESSAGE_POOL_HPP_
+#define ROSBAG2_STORAGE__SERIALIZED_MESSAGE_POOL_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "rcutils/allocator.h"
+#include "rcutils/types/uint8_array.h"
+
+#include "rosbag2_storage/visibility_control.hpp"
+
+// This is necessary because of using stl types here. It is completely safe, because
+// a) the member is not accessible from the outside
+// b) there are no inline functions.
+#ifdef _WIN32
+# pragma warning(push)
+# pragma warning(disable:4251)
+#endif
+
+namespace rosbag2_storage
+{
+
+/**
+ * Recycles the buffers of serialized messages. A buffer is handed out as a serialized message
+ * which returns it to the pool once the last reference to it is dropped, so the message stays
+ * valid for as long as it is used. Buffer capacities are rounded up to powers of two.
+ *
+ * The pool has to be owned by a std::shared_ptr. It is thread-safe and may be destroyed before
+ * the messages it handed out. Hits and misses are counted to allow judging its effectiveness.
+ */
+class ROSBAG2_STORAGE_PUBLIC SerializedMessagePool
+  : public std::enable_shared_from_this<SerializedMessagePool>
+{
+public:
+  /**
+   * \param max_pooled_bytes upper bound for the capacity of all buffers kept for reuse.
+   * \param allocator allocator for the message buffers, e.g. get_huge_page_allocator()
+   */
+  explicit SerializedMessagePool(
+    size_t max_pooled_bytes = 64 * 1024 * 1024,
+    rcutils_allocator_t allocator = rcutils_get_default_allocator());
+  SerializedMessagePool(const SerializedMessagePool &) = delete;
+  SerializedMessagePool & operator=(const SerializedMessagePool &) = delete;
+  ~SerializedMessagePool();
+
+  /**
+   * Get an empty serialized message with a capacity of at least the given size.
+   *
+   * \param size minimal capacity of the message buffer
+   * \return message with buffer_length 0
+   * \throws runtime_error if no buffer could be allocated
+   */
+  std::shared_ptr<rcutils_uint8_array_t> acquire(size_t size);
+
+  /**
+   * \return number of acquired messages whose buffer was reused
+   */
+  size_t get_hit_count() const;
+
+  /**
+   * \return number of acquired messages whose buffer had to be allocated
+   */
+  size_t get_miss_count() const;
+
+private:
+  void release(rcutils_uint8_array_t * message);
+
+  std::mutex mutex_;
+  size_t max_pooled_bytes_;
+  rcutils_allocator_t allocator_;
+  size_t pooled_bytes_;
+  // Free buffers indexed by the binary logarithm of their capacity
+  std::vector<std::vector<rcutils_uint8_array_t *>> free_buffers_;
+  std::atomic<size_t> hit_count_;
+  std::atomic<size_t> miss_count_;
+};
+
+}  // namespace rosbag2_storage
+
+#ifdef _WIN32
+# pragma warning(pop)
+#endif
+
+#endif  // ROSBAG2_STORAGE__SERIALIZED_MESSAGE_POOL_HPP_
@@ -19,7 +19,12 @@
 #include <string>
 #include <vector>
 
+#include "rcutils/time.h"
+
+#include "rosbag2_storage/read_position.hpp"
 #include "rosbag2_storage/serialized_bag_message.hpp"
+#include "rosbag2_storage/serialized_message_pool.hpp"
+#include "rosbag2_storage/storage_filter.hpp"
 #include "rosbag2_storage/topic_metadata.hpp"
 #include "rosbag2_storage/visibility_control.hpp"
 
@@ -38,6 +43,42 @@ public:
   virtual std::shared_ptr<SerializedBagMessage> read_next() = 0;
 
   virtual std::vector<TopicMetadata> get_all_topics_and_types() = 0;
+
+  /**
+   * Restrict the messages returned by has_next() and read_next() to the ones matching the
+   * filter. The filter applies to all messages not yet read.
+   */
+  virtual void set_filter(const StorageFilter & storage_filter) = 0;
+
+  virtual void reset_filter() = 0;
+
+  /**
+   * Continue reading with the first message whose timestamp is not smaller than the given one.
+   * This allows jumping forward as well as backward in time.
+   */
+  virtual void seek(const rcutils_time_point_value_t & timestamp) = 0;
+
+  /**
+   * Return the position of the message read last. Unlike seek(), passing it to
+   * set_read_position() continues reading exactly after that message, also if others share its
+   * timestamp.
+   */
+  virtual ReadPosition get_read_position() = 0;
+
+  /**
+   * Continue reading with the first message after the given position. Like seek(), this keeps
+   * the filter.
+   */
+  virtual void set_read_position(const ReadPosition & read_position) = 0;
+
+  /**
+   * Take the buffers of messages read from now on from the given pool. This is a hint only,
+   * storage plugins which do not allocate message buffers themselves may ignore it.
+   */
+  virtual void set_message_pool(std::shared_ptr<SerializedMessagePool> message_pool)
+  {
+    (void) message_pool;
+  }
 };
 
 }  // namespace storage_interfaces
@@ -20,8 +20,10 @@
 
 #include "rosbag2_storage/serialized_bag_message.hpp"
 #include "rosbag2_storage/bag_metadata.hpp"
+#include "rosbag2_storage/index_creation.hpp"
 #include "rosbag2_storage/topic_metadata.hpp"
 #include "rosbag2_storage/visibility_control.hpp"
+#include "rosbag2_storage/write_batch_limits.hpp"
 
 namespace rosbag2_storage
 {
@@ -35,9 +37,31 @@ public:
 
   virtual void write(std::shared_ptr<const SerializedBagMessage> msg) = 0;
 
-  virtual void create_topic(const TopicMetadata & topic) = 0;
+  /**
+   * Write a message of the topic with the given id, which spares looking up its name. The topic
+   * name of the message is ignored.
+   */
+  virtual void write(TopicId topic_id, std::shared_ptr<const SerializedBagMessage> msg) = 0;
+
+  /**
+   * Create the topic unless it exists already.
+   *
+   * \return id of the topic, valid until the topic is removed
+   */
+  virtual TopicId create_topic(const TopicMetadata & topic) = 0;
 
   virtual void remove_topic(const TopicMetadata & topic) = 0;
+
+  /**
+   * Set the limits for grouping written messages, applying from the next written message on.
+   */
+  virtual void set_write_batch_limits(const WriteBatchLimits & limits) = 0;
+
+  /**
+   * Set when the indices serving reads are created. Deferring their creation only takes effect
+   * before the first message is written.
+   */
+  virtual void set_index_creation(IndexCreation index_creation) = 0;
 };
 
 }  // namespace storage_interfaces
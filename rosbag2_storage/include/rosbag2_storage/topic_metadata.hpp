@@ -15,11 +15,15 @@
 #ifndef ROSBAG2_STORAGE__TOPIC_METADATA_HPP_
 #define ROSBAG2_STORAGE__TOPIC_METADATA_HPP_
 
+#include <cstdint>
 #include <string>
 
 namespace rosbag2_storage
 {
 
+// Handle of a created topic. It is only meaningful to the writer or storage which returned it.
+using TopicId = int32_t;
+
 struct TopicMetadata
 {
   std::string name;
@@ -0,0 +1,39 @@
+// Copyright 2018, Bosch Software Innovations GmbH.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROSBAG2_STORAGE__WRITE_BATCH_LIMITS_HPP_
+#define ROSBAG2_STORAGE__WRITE_BATCH_LIMITS_HPP_
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace rosbag2_storage
+{
+
+/**
+ * Limits for grouping written messages before they are committed together, e.g. in a single
+ * database transaction. The group is committed as soon as any of the limits is reached. A limit of
+ * 0 disables the respective check. Storages which do not group messages ignore the limits.
+ */
+struct WriteBatchLimits
+{
+  size_t max_messages = 1000;
+  uint64_t max_bytes = 8 * 1024 * 1024;
+  std::chrono::milliseconds max_duration = std::chrono::milliseconds(100);
+};
+
+}  // namespace rosbag2_storage
+
+#endif  // ROSBAG2_STORAGE__WRITE_BATCH_LIMITS_HPP_
@@ -0,0 +1,178 @@
+// Copyright 2018 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "rosbag2_storage/huge_page_allocator.hpp"
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+
+namespace rosbag2_storage
+{
+
+namespace
+{
+constexpr size_t huge_page_size = 2 * 1024 * 1024;
+
+// Precedes every block to tell how it has to be freed. Its alignment keeps the block aligned the
+// same way as blocks from malloc.
+struct alignas(std::max_align_t) BlockHeader
+{
+  size_t size;
+  bool is_mapped;
+};
+
+size_t get_mapping_length(size_t size)
+{
+  return (size + sizeof(BlockHeader) + huge_page_size - 1) / huge_page_size * huge_page_size;
+}
+
+#ifdef __linux__
+// Map more than needed and unmap the excess in front and behind, as huge pages need alignment
+void * map_huge_pages(size_t length)
+{
+  auto mapping = mmap(
+    nullptr, length + huge_page_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (mapping == MAP_FAILED) {
+    return nullptr;
+  }
+
+  auto start = reinterpret_cast<uintptr_t>(mapping);
+  auto aligned_start = (start + huge_page_size - 1) / huge_page_size * huge_page_size;
+  if (aligned_start > start) {
+    munmap(mapping, aligned_start - start);
+  }
+  munmap(
+    reinterpret_cast<void *>(aligned_start + length), huge_page_size - (aligned_start - start));
+
+  auto block = reinterpret_cast<void *>(aligned_start);
+#ifdef MADV_HUGEPAGE
+  madvise(block, length, MADV_HUGEPAGE);
+#endif
+  return block;
+}
+#endif
+
+void * allocate(size_t size, void * state)
+{
+  (void) state;
+  if (size > std::numeric_limits<size_t>::max() - sizeof(BlockHeader) - huge_page_size) {
+    return nullptr;
+  }
+
+  void * block = nullptr;
+  bool is_mapped = false;
+#ifdef __linux__
+  if (size >= huge_page_size) {
+    block = map_huge_pages(get_mapping_length(size));
+    is_mapped = block != nullptr;
+  }
+#endif
+  if (!block) {
+    block = std::malloc(size + sizeof(BlockHeader));
+    if (!block) {
+      return nullptr;
+    }
+  }
+
+  auto header = static_cast<BlockHeader *>(block);
+  header->size = size;
+  header->is_mapped = is_mapped;
+  return header + 1;
+}
+
+void deallocate(void * pointer, void * state)
+{
+  (void) state;
+  if (!pointer) {
+    return;
+  }
+
+  auto header = static_cast<BlockHeader *>(pointer) - 1;
+#ifdef __linux__
+  if (header->is_mapped) {
+    munmap(header, get_mapping_length(header->size));
+    return;
+  }
+#endif
+  std::free(header);
+}
+
+void * reallocate(void * pointer, size_t size, void * state)
+{
+  if (!pointer) {
+    return allocate(size, state);
+  }
+
+  auto header = static_cast<BlockHeader *>(pointer) - 1;
+  if (!header->is_mapped && size < huge_page_size) {
+    auto block = static_cast<BlockHeader *>(std::realloc(header, size + sizeof(BlockHeader)));
+    if (!block) {
+      return nullptr;
+    }
+    block->size = size;
+    return block + 1;
+  }
+  if (header->is_mapped && size >= huge_page_size &&
+    get_mapping_length(size) == get_mapping_length(header->size))
+  {
+    header->size = size;
+    return pointer;
+  }
+
+  auto new_pointer = allocate(size, state);
+  if (!new_pointer) {
+    return nullptr;
+  }
+  std::memcpy(new_pointer, pointer, std::min(size, header->size));
+  deallocate(pointer, state);
+  return new_pointer;
+}
+
+void * zero_allocate(size_t number_of_elements, size_t size_of_element, void * state)
+{
+  if (size_of_element != 0 &&
+    number_of_elements > std::numeric_limits<size_t>::max() / size_of_element)
+  {
+    return nullptr;
+  }
+
+  auto size = number_of_elements * size_of_element;
+  auto pointer = allocate(size, state);
+  if (pointer) {
+    std::memset(pointer, 0, size);
+  }
+  return pointer;
+}
+}  // namespace
+
+rcutils_allocator_t get_huge_page_allocator()
+{
+  rcutils_allocator_t allocator;
+  allocator.allocate = allocate;
+  allocator.deallocate = deallocate;
+  allocator.reallocate = reallocate;
+  allocator.zero_allocate = zero_allocate;
+  allocator.state = nullptr;
+  return allocator;
+}
+
+}  // namespace rosbag2_storage
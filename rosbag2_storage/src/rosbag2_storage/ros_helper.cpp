@@ -23,12 +23,10 @@
 namespace rosbag2_storage
 {
 
-static rcutils_allocator_t allocator = rcutils_get_default_allocator();
-
 std::shared_ptr<rcutils_uint8_array_t>
-make_serialized_message(const void * data, size_t size)
+make_serialized_message(const void * data, size_t size, rcutils_allocator_t allocator)
 {
-  auto serialized_message = make_empty_serialized_message(size);
+  auto serialized_message = make_empty_serialized_message(size, allocator);
   memcpy(serialized_message->buffer, data, size);
   serialized_message->buffer_length = size;
 
@@ -36,12 +34,13 @@ make_serialized_message(const void * data, size_t size)
 }
 
 std::shared_ptr<rcutils_uint8_array_t>
-make_empty_serialized_message(size_t size)
+make_empty_serialized_message(size_t size, rcutils_allocator_t allocator)
 {
   auto msg = new rcutils_uint8_array_t;
   *msg = rcutils_get_zero_initialized_uint8_array();
   auto ret = rcutils_uint8_array_init(msg, size, &allocator);
   if (ret != RCUTILS_RET_OK) {
+    delete msg;
     throw std::runtime_error("Error allocating resources for serialized message: " +
             std::string(rcutils_get_error_string().str));
   }
@@ -0,0 +1,147 @@
+// Copyright 2018 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "rosbag2_storage/serialized_message_pool.hpp"
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "rcutils/types.h"
+#include "rosbag2_storage/logging.hpp"
+
+namespace rosbag2_storage
+{
+
+namespace
+{
+// Smallest size class whose buffers can hold the given size
+size_t get_size_class_for_request(size_t size)
+{
+  size_t size_class = 0;
+  while ((static_cast<size_t>(1) << size_class) < size) {
+    ++size_class;
+  }
+  return size_class;
+}
+
+// Largest size class the given capacity satisfies, as users may have resized the buffer
+size_t get_size_class_for_capacity(size_t capacity)
+{
+  size_t size_class = 0;
+  while ((static_cast<size_t>(2) << size_class) <= capacity) {
+    ++size_class;
+  }
+  return size_class;
+}
+
+void destroy_message(rcutils_uint8_array_t * message)
+{
+  int error = rcutils_uint8_array_fini(message);
+  delete message;
+  if (error != RCUTILS_RET_OK) {
+    ROSBAG2_STORAGE_LOG_ERROR_STREAM("Leaking memory. Error: " << rcutils_get_error_string().str);
+  }
+}
+}  // namespace
+
+SerializedMessagePool::SerializedMessagePool(
+  size_t max_pooled_bytes, rcutils_allocator_t allocator)
+: max_pooled_bytes_(max_pooled_bytes), allocator_(allocator), pooled_bytes_(0), hit_count_(0),
+  miss_count_(0)
+{}
+
+SerializedMessagePool::~SerializedMessagePool()
+{
+  for (auto & buffers : free_buffers_) {
+    for (auto message : buffers) {
+      destroy_message(message);
+    }
+  }
+}
+
+std::shared_ptr<rcutils_uint8_array_t> SerializedMessagePool::acquire(size_t size)
+{
+  const auto size_class = get_size_class_for_request(size);
+  rcutils_uint8_array_t * message = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (size_class < free_buffers_.size() && !free_buffers_[size_class].empty()) {
+      message = free_buffers_[size_class].back();
+      free_buffers_[size_class].pop_back();
+      pooled_bytes_ -= message->buffer_capacity;
+    }
+  }
+
+  if (message) {
+    ++hit_count_;
+  } else {
+    ++miss_count_;
+    message = new rcutils_uint8_array_t;
+    *message = rcutils_get_zero_initialized_uint8_array();
+    auto ret = rcutils_uint8_array_init(
+      message, static_cast<size_t>(1) << size_class, &allocator_);
+    if (ret != RCUTILS_RET_OK) {
+      delete message;
+      throw std::runtime_error("Error allocating resources for serialized message: " +
+              std::string(rcutils_get_error_string().str));
+    }
+  }
+  message->buffer_length = 0;
+
+  std::weak_ptr<SerializedMessagePool> weak_pool = shared_from_this();
+  return std::shared_ptr<rcutils_uint8_array_t>(message,
+           [weak_pool](rcutils_uint8_array_t * message) {
+             if (auto pool = weak_pool.lock()) {
+               pool->release(message);
+             } else {
+               destroy_message(message);
+             }
+           });
+}
+
+size_t SerializedMessagePool::get_hit_count() const
+{
+  return hit_count_;
+}
+
+size_t SerializedMessagePool::get_miss_count() const
+{
+  return miss_count_;
+}
+
+void SerializedMessagePool::release(rcutils_uint8_array_t * message)
+{
+  if (message->buffer_capacity == 0) {
+    destroy_message(message);
+    return;
+  }
+
+  const auto size_class = get_size_class_for_capacity(message->buffer_capacity);
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (pooled_bytes_ + message->buffer_capacity <= max_pooled_bytes_) {
+      if (free_buffers_.size() <= size_class) {
+        free_buffers_.resize(size_class + 1);
+      }
+      free_buffers_[size_class].push_back(message);
+      pooled_bytes_ += message->buffer_capacity;
+      return;
+    }
+  }
+  destroy_message(message);
+}
+
+}  // namespace rosbag2_storage
@@ -0,0 +1,80 @@
+// Copyright 2018 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gmock/gmock.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "rosbag2_storage/huge_page_allocator.hpp"
+#include "rosbag2_storage/ros_helper.hpp"
+
+using namespace ::testing;  // NOLINT
+
+namespace
+{
+const size_t huge_page_size = 2 * 1024 * 1024;
+}
+
+TEST(huge_page_allocator, allocates_small_and_huge_blocks) {
+  auto allocator = rosbag2_storage::get_huge_page_allocator();
+
+  for (auto size : {size_t(1), size_t(1000), huge_page_size, 3 * huge_page_size + 1}) {
+    auto block = static_cast<uint8_t *>(allocator.allocate(size, allocator.state));
+    ASSERT_THAT(block, NotNull());
+    EXPECT_THAT(reinterpret_cast<uintptr_t>(block) % alignof(std::max_align_t), Eq(0u));
+    std::memset(block, 42, size);
+    EXPECT_THAT(block[size - 1], Eq(42));
+    allocator.deallocate(block, allocator.state);
+  }
+}
+
+TEST(huge_page_allocator, reallocation_keeps_contents_across_huge_page_size) {
+  auto allocator = rosbag2_storage::get_huge_page_allocator();
+
+  auto block = static_cast<uint8_t *>(allocator.allocate(100, allocator.state));
+  block[99] = 1;
+  block = static_cast<uint8_t *>(allocator.reallocate(block, 2 * huge_page_size, allocator.state));
+  ASSERT_THAT(block, NotNull());
+  EXPECT_THAT(block[99], Eq(1));
+
+  block[2 * huge_page_size - 1] = 2;
+  block = static_cast<uint8_t *>(allocator.reallocate(block, 100, allocator.state));
+  ASSERT_THAT(block, NotNull());
+  EXPECT_THAT(block[99], Eq(1));
+  allocator.deallocate(block, allocator.state);
+}
+
+TEST(huge_page_allocator, zero_allocated_blocks_are_zeroed) {
+  auto allocator = rosbag2_storage::get_huge_page_allocator();
+
+  auto block = static_cast<uint8_t *>(
+    allocator.zero_allocate(huge_page_size, 2, allocator.state));
+  ASSERT_THAT(block, NotNull());
+  EXPECT_THAT(block[0], Eq(0));
+  EXPECT_THAT(block[2 * huge_page_size - 1], Eq(0));
+  allocator.deallocate(block, allocator.state);
+}
+
+TEST(huge_page_allocator, backs_serialized_messages) {
+  std::vector<uint8_t> data(huge_page_size, 7);
+
+  auto message = rosbag2_storage::make_serialized_message(
+    data.data(), data.size(), rosbag2_storage::get_huge_page_allocator());
+
+  ASSERT_THAT(message->buffer_length, Eq(huge_page_size));
+  EXPECT_THAT(message->buffer[huge_page_size - 1], Eq(7));
+}
@@ -52,9 +52,10 @@ std::shared_ptr<rosbag2_storage::SerializedBagMessage> TestPlugin::read_next()
   return std::shared_ptr<rosbag2_storage::SerializedBagMessage>();
 }
 
-void TestPlugin::create_topic(const rosbag2_storage::TopicMetadata & topic)
+rosbag2_storage::TopicId TestPlugin::create_topic(const rosbag2_storage::TopicMetadata & topic)
 {
   std::cout << "Created topic with name =" << topic.name << " and type =" << topic.type << ".\n";
+  return 0;
 }
 
 void TestPlugin::remove_topic(const rosbag2_storage::TopicMetadata & topic)
@@ -62,12 +63,30 @@ void TestPlugin::remove_topic(const rosbag2_storage::TopicMetadata & topic)
   std::cout << "Removed topic with name =" << topic.name << " and type =" << topic.type << ".\n";
 }
 
+void TestPlugin::set_write_batch_limits(const rosbag2_storage::WriteBatchLimits & limits)
+{
+  std::cout << "\nsetting write batch limits to " << limits.max_messages << " messages\n";
+}
+
+void TestPlugin::set_index_creation(rosbag2_storage::IndexCreation index_creation)
+{
+  std::cout << "\nsetting index creation to " << static_cast<int>(index_creation) << "\n";
+}
+
 void TestPlugin::write(const std::shared_ptr<const rosbag2_storage::SerializedBagMessage> msg)
 {
   (void) msg;
   std::cout << "\nwriting\n";
 }
 
+void TestPlugin::write(
+  rosbag2_storage::TopicId topic_id,
+  const std::shared_ptr<const rosbag2_storage::SerializedBagMessage> msg)
+{
+  (void) msg;
+  std::cout << "\nwriting to topic " << topic_id << "\n";
+}
+
 std::vector<rosbag2_storage::TopicMetadata> TestPlugin::get_all_topics_and_types()
 {
   std::cout << "\nreading topics and types\n";
@@ -80,6 +99,34 @@ rosbag2_storage::BagMetadata TestPlugin::get_metadata()
   return rosbag2_storage::BagMetadata();
 }
 
+void TestPlugin::set_filter(const rosbag2_storage::StorageFilter & storage_filter)
+{
+  (void) storage_filter;
+  std::cout << "\nsetting storage filter\n";
+}
+
+void TestPlugin::reset_filter()
+{
+  std::cout << "\nresetting storage filter\n";
+}
+
+void TestPlugin::seek(const rcutils_time_point_value_t & timestamp)
+{
+  std::cout << "\nseeking to " << timestamp << "\n";
+}
+
+rosbag2_storage::ReadPosition TestPlugin::get_read_position()
+{
+  std::cout << "\nreturning read position\n";
+  return {0, 0};
+}
+
+void TestPlugin::set_read_position(const rosbag2_storage::ReadPosition & read_position)
+{
+  std::cout << "\nsetting read position to " << read_position.time_stamp << ", " <<
+    read_position.id << "\n";
+}
+
 std::string TestPlugin::get_relative_path() const
 {
   std::cout << "\nreturning relative path\n";
@@ -31,18 +31,36 @@ public:
 
   void open(const std::string & uri, rosbag2_storage::storage_interfaces::IOFlag flag) override;
 
-  void create_topic(const rosbag2_storage::TopicMetadata & topic) override;
+  rosbag2_storage::TopicId create_topic(const rosbag2_storage::TopicMetadata & topic) override;
 
   void remove_topic(const rosbag2_storage::TopicMetadata & topic) override;
 
+  void set_write_batch_limits(const rosbag2_storage::WriteBatchLimits & limits) override;
+
+  void set_index_creation(rosbag2_storage::IndexCreation index_creation) override;
+
   bool has_next() override;
 
   std::shared_ptr<rosbag2_storage::SerializedBagMessage> read_next() override;
 
   void write(std::shared_ptr<const rosbag2_storage::SerializedBagMessage> msg) override;
 
+  void write(
+    rosbag2_storage::TopicId topic_id,
+    std::shared_ptr<const rosbag2_storage::SerializedBagMessage> msg) override;
+
   std::vector<rosbag2_storage::TopicMetadata> get_all_topics_and_types() override;
 
+  void set_filter(const rosbag2_storage::StorageFilter & storage_filter) override;
+
+  void reset_filter() override;
+
+  void seek(const rcutils_time_point_value_t & timestamp) override;
+
+  rosbag2_storage::ReadPosition get_read_position() override;
+
+  void set_read_position(const rosbag2_storage::ReadPosition & read_position) override;
+
   rosbag2_storage::BagMetadata get_metadata() override;
 
   std::string get_relative_path() const override;
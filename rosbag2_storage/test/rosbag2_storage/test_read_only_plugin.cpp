@@ -55,6 +55,34 @@ std::vector<rosbag2_storage::TopicMetadata> TestReadOnlyPlugin::get_all_topics_a
   return std::vector<rosbag2_storage::TopicMetadata>();
 }
 
+void TestReadOnlyPlugin::set_filter(const rosbag2_storage::StorageFilter & storage_filter)
+{
+  (void) storage_filter;
+  std::cout << "\nsetting storage filter\n";
+}
+
+void TestReadOnlyPlugin::reset_filter()
+{
+  std::cout << "\nresetting storage filter\n";
+}
+
+void TestReadOnlyPlugin::seek(const rcutils_time_point_value_t & timestamp)
+{
+  std::cout << "\nseeking to " << timestamp << "\n";
+}
+
+rosbag2_storage::ReadPosition TestReadOnlyPlugin::get_read_position()
+{
+  std::cout << "\nreturning read position\n";
+  return {0, 0};
+}
+
+void TestReadOnlyPlugin::set_read_position(const rosbag2_storage::ReadPosition & read_position)
+{
+  std::cout << "\nsetting read position to " << read_position.time_stamp << ", " <<
+    read_position.id << "\n";
+}
+
 std::string TestReadOnlyPlugin::get_relative_path() const
 {
   std::cout << "\nreturning relative path\n";
@@ -34,6 +34,16 @@ public:
 
   std::vector<rosbag2_storage::TopicMetadata> get_all_topics_and_types() override;
 
+  void set_filter(const rosbag2_storage::StorageFilter & storage_filter) override;
+
+  void reset_filter() override;
+
+  void seek(const rcutils_time_point_value_t & timestamp) override;
+
+  rosbag2_storage::ReadPosition get_read_position() override;
+
+  void set_read_position(const rosbag2_storage::ReadPosition & read_position) override;
+
   rosbag2_storage::BagMetadata get_metadata() override;
 
   std::string get_relative_path() const override;
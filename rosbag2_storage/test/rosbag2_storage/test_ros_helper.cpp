@@ -41,3 +41,18 @@ TEST(ros_helper, make_empty_serialized_message_is_correctly_built) {
   ASSERT_THAT(empty_serialized_message->buffer_length, Eq(0u));
   ASSERT_THAT(empty_serialized_message->buffer_capacity, Eq(size));
 }
+
+TEST(ros_helper, make_empty_serialized_message_uses_given_allocator) {
+  static size_t allocation_count = 0;
+  auto allocator = rcutils_get_default_allocator();
+  allocator.allocate = [](size_t size, void * state) {
+      (void) state;
+      ++allocation_count;
+      return malloc(size);
+    };
+
+  auto empty_serialized_message = rosbag2_storage::make_empty_serialized_message(32, allocator);
+
+  ASSERT_THAT(allocation_count, Eq(1u));
+  ASSERT_THAT(empty_serialized_message->buffer_capacity, Eq(32u));
+}
@@ -0,0 +1,80 @@
+// Copyright 2018 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gmock/gmock.h>
+
+#include <memory>
+
+#include "rosbag2_storage/serialized_message_pool.hpp"
+
+using namespace ::testing;  // NOLINT
+
+TEST(serialized_message_pool, acquired_message_is_empty_and_large_enough) {
+  auto pool = std::make_shared<rosbag2_storage::SerializedMessagePool>();
+
+  auto message = pool->acquire(100);
+
+  ASSERT_THAT(message->buffer_length, Eq(0u));
+  ASSERT_THAT(message->buffer_capacity, Ge(100u));
+}
+
+TEST(serialized_message_pool, released_buffers_are_reused_for_fitting_sizes) {
+  auto pool = std::make_shared<rosbag2_storage::SerializedMessagePool>();
+
+  auto message = pool->acquire(100);
+  message->buffer_length = 100;
+  auto buffer = message->buffer;
+  message.reset();
+
+  auto reused_message = pool->acquire(80);
+  EXPECT_THAT(reused_message->buffer, Eq(buffer));
+  EXPECT_THAT(reused_message->buffer_length, Eq(0u));
+
+  auto bigger_message = pool->acquire(1000);
+  EXPECT_THAT(bigger_message->buffer, Ne(buffer));
+}
+
+TEST(serialized_message_pool, buffers_exceeding_the_pool_limit_are_not_kept) {
+  auto pool = std::make_shared<rosbag2_storage::SerializedMessagePool>(64);
+
+  auto message = pool->acquire(1000);
+  message.reset();
+
+  auto second_message = pool->acquire(1000);
+  auto small_message = pool->acquire(10);
+  EXPECT_THAT(second_message->buffer_capacity, Ge(1000u));
+  EXPECT_THAT(small_message->buffer_capacity, Ge(10u));
+}
+
+TEST(serialized_message_pool, messages_outlive_the_pool) {
+  auto pool = std::make_shared<rosbag2_storage::SerializedMessagePool>();
+
+  auto message = pool->acquire(10);
+  pool.reset();
+
+  message->buffer[0] = 42;
+  EXPECT_THAT(message->buffer[0], Eq(42));
+}
+
+TEST(serialized_message_pool, reused_and_allocated_buffers_are_counted) {
+  auto pool = std::make_shared<rosbag2_storage::SerializedMessagePool>();
+
+  pool->acquire(100).reset();
+  pool->acquire(100).reset();
+  auto first_message = pool->acquire(100);
+  auto second_message = pool->acquire(100);
+
+  EXPECT_THAT(pool->get_hit_count(), Eq(2u));
+  EXPECT_THAT(pool->get_miss_count(), Eq(2u));
+}
@@ -0,0 +1,74 @@
+// Copyright 2018, Bosch Software Innovations GmbH.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROSBAG2_STORAGE_DEFAULT_PLUGINS__SQLITE__SQLITE_BLOB_READER_HPP_
+#define ROSBAG2_STORAGE_DEFAULT_PLUGINS__SQLITE__SQLITE_BLOB_READER_HPP_
+
+#include <sqlite3.h>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "rcutils/types/uint8_array.h"
+#include "rosbag2_storage/serialized_message_pool.hpp"
+#include "rosbag2_storage_default_plugins/visibility_control.hpp"
+
+// This is necessary because of using stl types here. It is completely safe, because
+// a) the member is not accessible from the outside
+// b) there are no inline functions.
+#ifdef _WIN32
+# pragma warning(push)
+# pragma warning(disable:4251)
+#endif
+
+namespace rosbag2_storage_plugins
+{
+
+/**
+ * Reads blobs of one column through SQLite's incremental blob I/O. The data is copied from the
+ * database pages directly into a buffer taken from a pool, without SQLite assembling the blob
+ * in an intermediate buffer first. One blob handle is kept open and moved from row to row.
+ */
+class ROSBAG2_STORAGE_DEFAULT_PLUGINS_PUBLIC SqliteBlobReader
+{
+public:
+  SqliteBlobReader(
+    sqlite3 * database, const std::string & table, const std::string & column,
+    std::shared_ptr<rosbag2_storage::SerializedMessagePool> message_pool);
+  SqliteBlobReader(const SqliteBlobReader &) = delete;
+  SqliteBlobReader & operator=(const SqliteBlobReader &) = delete;
+  ~SqliteBlobReader();
+
+  std::shared_ptr<rcutils_uint8_array_t> read(int64_t row_id);
+
+private:
+  void open_row(int64_t row_id);
+
+  sqlite3 * database_;
+  std::string table_;
+  std::string column_;
+  std::shared_ptr<rosbag2_storage::SerializedMessagePool> message_pool_;
+  sqlite3_blob * blob_;
+};
+
+using SqliteBlobReaderPtr = std::shared_ptr<SqliteBlobReader>;
+
+}  // namespace rosbag2_storage_plugins
+
+#ifdef _WIN32
+# pragma warning(pop)
+#endif
+
+#endif  // ROSBAG2_STORAGE_DEFAULT_PLUGINS__SQLITE__SQLITE_BLOB_READER_HPP_
@@ -15,15 +15,23 @@
 #ifndef ROSBAG2_STORAGE_DEFAULT_PLUGINS__SQLITE__SQLITE_STORAGE_HPP_
 #define ROSBAG2_STORAGE_DEFAULT_PLUGINS__SQLITE__SQLITE_STORAGE_HPP_
 
+#include <chrono>
+#include <cstdint>
+#include <limits>
 #include <memory>
 #include <string>
+#include <tuple>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include "rcutils/types.h"
 #include "rosbag2_storage/storage_interfaces/read_write_interface.hpp"
 #include "rosbag2_storage/serialized_bag_message.hpp"
+#include "rosbag2_storage/storage_filter.hpp"
+#include "rosbag2_storage/index_creation.hpp"
 #include "rosbag2_storage/topic_metadata.hpp"
+#include "rosbag2_storage/write_batch_limits.hpp"
 #include "rosbag2_storage_default_plugins/sqlite/sqlite_wrapper.hpp"
 #include "rosbag2_storage_default_plugins/visibility_control.hpp"
 
@@ -38,12 +46,30 @@
 namespace rosbag2_storage_plugins
 {
 
+/**
+ * Limits for grouping written messages into a single SQLite transaction. They are passed either
+ * on construction or, for storages loaded as plugin, by set_write_batch_limits() from the
+ * Writer's StorageOptions. Messages still pending in an open transaction are committed on
+ * destruction of the storage.
+ */
+using WriteTransactionLimits = rosbag2_storage::WriteBatchLimits;
+
+/**
+ * Point in time at which the indices of the messages table are created. Deferred indices are
+ * created on destruction of the storage, or before reading from it. Storages loaded as plugin get
+ * the Writer's StorageOptions::index_creation by set_index_creation().
+ */
+using IndexCreation = rosbag2_storage::IndexCreation;
+
 class ROSBAG2_STORAGE_DEFAULT_PLUGINS_PUBLIC SqliteStorage
   : public rosbag2_storage::storage_interfaces::ReadWriteInterface
 {
 public:
   SqliteStorage() = default;
-  ~SqliteStorage() override = default;
+  explicit SqliteStorage(
+    const WriteTransactionLimits & transaction_limits,
+    IndexCreation index_creation = IndexCreation::BEFORE_WRITING);
+  ~SqliteStorage() override;
 
   void open(
     const std::string & uri,
@@ -52,16 +78,37 @@ public:
 
   void remove_topic(const rosbag2_storage::TopicMetadata & topic) override;
 
-  void create_topic(const rosbag2_storage::TopicMetadata & topic) override;
+  void set_write_batch_limits(const rosbag2_storage::WriteBatchLimits & limits) override;
+
+  void set_index_creation(IndexCreation index_creation) override;
+
+  rosbag2_storage::TopicId create_topic(const rosbag2_storage::TopicMetadata & topic) override;
 
   void write(std::shared_ptr<const rosbag2_storage::SerializedBagMessage> message) override;
 
+  void write(
+    rosbag2_storage::TopicId topic_id,
+    std::shared_ptr<const rosbag2_storage::SerializedBagMessage> message) override;
+
   bool has_next() override;
 
   std::shared_ptr<rosbag2_storage::SerializedBagMessage> read_next() override;
 
   std::vector<rosbag2_storage::TopicMetadata> get_all_topics_and_types() override;
 
+  void set_filter(const rosbag2_storage::StorageFilter & storage_filter) override;
+
+  void reset_filter() override;
+
+  void seek(const rcutils_time_point_value_t & timestamp) override;
+
+  rosbag2_storage::ReadPosition get_read_position() override;
+
+  void set_read_position(const rosbag2_storage::ReadPosition & read_position) override;
+
+  void set_message_pool(
+    std::shared_ptr<rosbag2_storage::SerializedMessagePool> message_pool) override;
+
   rosbag2_storage::BagMetadata get_metadata() override;
 
   std::string get_relative_path() const override;
@@ -72,26 +119,70 @@ public:
 
 private:
   void initialize();
+  void create_indices();
+  void drop_indices();
   void prepare_for_writing();
+  void begin_write_transaction();
+  void commit_write_transaction();
+  bool is_write_transaction_limit_reached() const;
+  void update_topic_statistics(int topic_id, const rosbag2_storage::SerializedBagMessage & message);
+  void write_topic_statistics();
+  bool has_topic_statistics() const;
+  double get_message_share(const std::vector<int> & topic_ids) const;
   void prepare_for_reading();
+  void fill_topic_names();
+  const std::string & get_topic_name(int topic_id) const;
   void fill_topics_and_types();
 
   std::unique_ptr<rosbag2_storage::BagMetadata> load_metadata(const std::string & uri);
   bool is_read_only(const rosbag2_storage::storage_interfaces::IOFlag & io_flag) const;
 
   using ReadQueryResult = SqliteStatementWrapper::QueryResult<
-    std::shared_ptr<rcutils_uint8_array_t>, rcutils_time_point_value_t, std::string>;
+    int64_t, rcutils_time_point_value_t, int>;
+
+  struct TopicStatistics
+  {
+    int64_t message_count = 0;
+    rcutils_time_point_value_t min_timestamp =
+      std::numeric_limits<rcutils_time_point_value_t>::max();
+    rcutils_time_point_value_t max_timestamp =
+      std::numeric_limits<rcutils_time_point_value_t>::min();
+    int64_t total_bytes = 0;
+  };
 
   std::shared_ptr<SqliteWrapper> database_;
   std::string database_name_;
   SqliteStatement write_statement_ {};
+  SqliteStatement begin_transaction_statement_ {};
+  SqliteStatement commit_transaction_statement_ {};
+  SqliteStatement write_statistics_statement_ {};
   SqliteStatement read_statement_ {};
+  SqliteBlobReaderPtr blob_reader_ {};
+  std::shared_ptr<rosbag2_storage::SerializedMessagePool> message_pool_ =
+    std::make_shared<rosbag2_storage::SerializedMessagePool>();
   ReadQueryResult message_result_ {nullptr};
   ReadQueryResult::Iterator current_message_row_ {
     nullptr, SqliteStatementWrapper::QueryResult<>::Iterator::POSITION_END};
   std::unordered_map<std::string, int> topics_;
+  std::unordered_map<int, std::string> topic_names_;
+  rosbag2_storage::StorageFilter storage_filter_;
+  // Timestamp and id of the last message read
+  std::tuple<rcutils_time_point_value_t, int64_t> read_position_ {
+    std::numeric_limits<rcutils_time_point_value_t>::min(), std::numeric_limits<int64_t>::min()};
   std::vector<rosbag2_storage::TopicMetadata> all_topics_and_types_;
   std::string uri_;
+
+  WriteTransactionLimits transaction_limits_;
+  bool is_transaction_open_ = false;
+  size_t messages_in_transaction_ = 0;
+  size_t bytes_in_transaction_ = 0;
+  std::chrono::steady_clock::time_point transaction_start_time_;
+  // Statistics of all topics written so far and ids of those changed in the open transaction
+  std::unordered_map<int, TopicStatistics> topic_statistics_;
+  std::unordered_set<int> changed_topic_statistics_;
+
+  IndexCreation index_creation_ = IndexCreation::BEFORE_WRITING;
+  bool are_indices_pending_ = false;
 };
 
 }  // namespace rosbag2_storage_plugins
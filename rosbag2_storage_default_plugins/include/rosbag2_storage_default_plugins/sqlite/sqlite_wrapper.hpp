@@ -23,7 +23,9 @@
 
 #include "rcutils/types.h"
 #include "rosbag2_storage/serialized_bag_message.hpp"
+#include "rosbag2_storage/serialized_message_pool.hpp"
 #include "rosbag2_storage/storage_interfaces/base_io_interface.hpp"
+#include "rosbag2_storage_default_plugins/sqlite/sqlite_blob_reader.hpp"
 #include "rosbag2_storage_default_plugins/sqlite/sqlite_statement_wrapper.hpp"
 #include "rosbag2_storage_default_plugins/visibility_control.hpp"
 
@@ -41,6 +43,10 @@ public:
 
   SqliteStatement prepare_statement(const std::string & query);
 
+  SqliteBlobReaderPtr open_blob_reader(
+    const std::string & table, const std::string & column,
+    std::shared_ptr<rosbag2_storage::SerializedMessagePool> message_pool);
+
   size_t get_last_insert_id();
 
   operator bool();
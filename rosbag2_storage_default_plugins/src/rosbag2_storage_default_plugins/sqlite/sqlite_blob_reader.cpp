@@ -0,0 +1,80 @@
+// Copyright 2018, Bosch Software Innovations GmbH.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "rosbag2_storage_default_plugins/sqlite/sqlite_blob_reader.hpp"
+
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "rosbag2_storage_default_plugins/sqlite/sqlite_exception.hpp"
+
+namespace rosbag2_storage_plugins
+{
+
+SqliteBlobReader::SqliteBlobReader(
+  sqlite3 * database, const std::string & table, const std::string & column,
+  std::shared_ptr<rosbag2_storage::SerializedMessagePool> message_pool)
+: database_(database),
+  table_(table),
+  column_(column),
+  message_pool_(std::move(message_pool)),
+  blob_(nullptr)
+{}
+
+SqliteBlobReader::~SqliteBlobReader()
+{
+  if (blob_) {
+    sqlite3_blob_close(blob_);
+  }
+}
+
+std::shared_ptr<rcutils_uint8_array_t> SqliteBlobReader::read(int64_t row_id)
+{
+  open_row(row_id);
+
+  auto size = sqlite3_blob_bytes(blob_);
+  auto message = message_pool_->acquire(static_cast<size_t>(size));
+  int return_code = sqlite3_blob_read(blob_, message->buffer, size, 0);
+  if (return_code != SQLITE_OK) {
+    throw SqliteException("Error reading blob of row " + std::to_string(row_id) +
+            ". Return code: " + std::to_string(return_code));
+  }
+  message->buffer_length = static_cast<size_t>(size);
+
+  return message;
+}
+
+void SqliteBlobReader::open_row(int64_t row_id)
+{
+  int return_code = SQLITE_OK;
+  if (blob_) {
+    // Moving an open handle is considerably cheaper than opening a new one
+    return_code = sqlite3_blob_reopen(blob_, row_id);
+    if (return_code != SQLITE_OK) {
+      sqlite3_blob_close(blob_);
+      blob_ = nullptr;
+    }
+  } else {
+    return_code = sqlite3_blob_open(
+      database_, "main", table_.c_str(), column_.c_str(), row_id, 0, &blob_);
+  }
+
+  if (return_code != SQLITE_OK) {
+    throw SqliteException("Error opening blob of row " + std::to_string(row_id) +
+            ". Return code: " + std::to_string(return_code));
+  }
+}
+
+}  // namespace rosbag2_storage_plugins
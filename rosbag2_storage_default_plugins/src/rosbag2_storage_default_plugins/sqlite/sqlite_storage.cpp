@@ -16,12 +16,15 @@
 
 #include <sys/stat.h>
 
+#include <algorithm>
 #include <chrono>
 #include <cstring>
 #include <iostream>
 #include <fstream>
+#include <limits>
 #include <memory>
 #include <string>
+#include <tuple>
 #include <utility>
 #include <vector>
 
@@ -40,11 +43,39 @@ bool database_exists(const std::string & uri)
   std::ifstream database(uri);
   return database.good();
 }
+
+// Topic filters on a smaller share of the messages are read through topic_timestamp_idx
+constexpr double max_share_read_by_topic = 0.1;
 }
 
 namespace rosbag2_storage_plugins
 {
 
+SqliteStorage::SqliteStorage(
+  const WriteTransactionLimits & transaction_limits, IndexCreation index_creation)
+: transaction_limits_(transaction_limits), index_creation_(index_creation)
+{}
+
+SqliteStorage::~SqliteStorage()
+{
+  if (is_transaction_open_) {
+    try {
+      commit_write_transaction();
+    } catch (const SqliteException & e) {
+      ROSBAG2_STORAGE_DEFAULT_PLUGINS_LOG_ERROR(
+        "Failed to commit pending messages to database: %s", e.what());
+    }
+  }
+  if (are_indices_pending_) {
+    try {
+      create_indices();
+    } catch (const SqliteException & e) {
+      ROSBAG2_STORAGE_DEFAULT_PLUGINS_LOG_ERROR(
+        "Failed to create indices, reading will be slower: %s", e.what());
+    }
+  }
+}
+
 void SqliteStorage::open(
   const std::string & uri, rosbag2_storage::storage_interfaces::IOFlag io_flag)
 {
@@ -89,17 +120,40 @@ void SqliteStorage::open(
 
 void SqliteStorage::write(std::shared_ptr<const rosbag2_storage::SerializedBagMessage> message)
 {
-  if (!write_statement_) {
-    prepare_for_writing();
-  }
   auto topic_entry = topics_.find(message->topic_name);
   if (topic_entry == end(topics_)) {
     throw SqliteException("Topic '" + message->topic_name +
             "' has not been created yet! Call 'create_topic' first.");
   }
 
-  write_statement_->bind(message->time_stamp, topic_entry->second, message->serialized_data);
+  write(topic_entry->second, message);
+}
+
+void SqliteStorage::write(
+  rosbag2_storage::TopicId topic_id,
+  std::shared_ptr<const rosbag2_storage::SerializedBagMessage> message)
+{
+  if (!write_statement_) {
+    prepare_for_writing();
+  }
+  if (topic_names_.find(topic_id) == std::end(topic_names_)) {
+    throw SqliteException("Topic with id " + std::to_string(topic_id) +
+            " has not been created yet! Call 'create_topic' first.");
+  }
+
+  if (!is_transaction_open_) {
+    begin_write_transaction();
+  }
+
+  write_statement_->bind(message->time_stamp, topic_id, message->serialized_data);
   write_statement_->execute_and_reset();
+  update_topic_statistics(topic_id, *message);
+
+  ++messages_in_transaction_;
+  bytes_in_transaction_ += message->serialized_data->buffer_length;
+  if (is_write_transaction_limit_reached()) {
+    commit_write_transaction();
+  }
 }
 
 bool SqliteStorage::has_next()
@@ -118,10 +172,11 @@ std::shared_ptr<rosbag2_storage::SerializedBagMessage> SqliteStorage::read_next(
   }
 
   auto bag_message = std::make_shared<rosbag2_storage::SerializedBagMessage>();
-  bag_message->serialized_data = std::get<0>(*current_message_row_);
+  bag_message->serialized_data = blob_reader_->read(std::get<0>(*current_message_row_));
   bag_message->time_stamp = std::get<1>(*current_message_row_);
-  bag_message->topic_name = std::get<2>(*current_message_row_);
+  bag_message->topic_name = get_topic_name(std::get<2>(*current_message_row_));
 
+  read_position_ = std::make_tuple(bag_message->time_stamp, std::get<0>(*current_message_row_));
   ++current_message_row_;
   return bag_message;
 }
@@ -135,6 +190,64 @@ std::vector<rosbag2_storage::TopicMetadata> SqliteStorage::get_all_topics_and_ty
   return all_topics_and_types_;
 }
 
+void SqliteStorage::set_filter(const rosbag2_storage::StorageFilter & storage_filter)
+{
+  storage_filter_ = storage_filter;
+  // The query is prepared anew on the next read, continuing after the last message read
+  read_statement_ = nullptr;
+}
+
+void SqliteStorage::reset_filter()
+{
+  set_filter(rosbag2_storage::StorageFilter());
+}
+
+void SqliteStorage::seek(const rcutils_time_point_value_t & timestamp)
+{
+  // Served by timestamp_idx: the query restarts at the first message with a timestamp >= given
+  read_position_ = std::make_tuple(timestamp, std::numeric_limits<int64_t>::min());
+  read_statement_ = nullptr;
+}
+
+rosbag2_storage::ReadPosition SqliteStorage::get_read_position()
+{
+  return {std::get<0>(read_position_), std::get<1>(read_position_)};
+}
+
+void SqliteStorage::set_read_position(const rosbag2_storage::ReadPosition & read_position)
+{
+  read_position_ = std::make_tuple(read_position.time_stamp, read_position.id);
+  read_statement_ = nullptr;
+}
+
+void SqliteStorage::set_message_pool(
+  std::shared_ptr<rosbag2_storage::SerializedMessagePool> message_pool)
+{
+  message_pool_ = message_pool;
+  read_statement_ = nullptr;
+}
+
+void SqliteStorage::set_write_batch_limits(const rosbag2_storage::WriteBatchLimits & limits)
+{
+  transaction_limits_ = limits;
+}
+
+void SqliteStorage::set_index_creation(IndexCreation index_creation)
+{
+  index_creation_ = index_creation;
+  // Without database, the indices are created according to the mode when it is initialized
+  if (!database_) {
+    return;
+  }
+  if (index_creation_ == IndexCreation::BEFORE_WRITING && are_indices_pending_) {
+    create_indices();
+  } else if (index_creation_ == IndexCreation::AFTER_WRITING && !are_indices_pending_ &&
+    !write_statement_)
+  {
+    drop_indices();
+  }
+}
+
 uint64_t SqliteStorage::get_bagfile_size() const
 {
   return rosbag2_storage::FilesystemHelper::get_file_size(
@@ -155,20 +268,54 @@ void SqliteStorage::initialize()
     "timestamp INTEGER NOT NULL, " \
     "data BLOB NOT NULL);";
   database_->prepare_statement(create_stmt)->execute_and_reset();
-  create_stmt = "CREATE INDEX timestamp_idx ON messages (timestamp ASC);";
+  create_stmt = "CREATE TABLE topic_statistics(" \
+    "topic_id INTEGER PRIMARY KEY," \
+    "message_count INTEGER NOT NULL," \
+    "min_timestamp INTEGER NOT NULL," \
+    "max_timestamp INTEGER NOT NULL," \
+    "total_bytes INTEGER NOT NULL);";
   database_->prepare_statement(create_stmt)->execute_and_reset();
+
+  if (index_creation_ == IndexCreation::BEFORE_WRITING) {
+    create_indices();
+  } else {
+    are_indices_pending_ = true;
+  }
 }
 
-void SqliteStorage::create_topic(const rosbag2_storage::TopicMetadata & topic)
+void SqliteStorage::create_indices()
 {
-  if (topics_.find(topic.name) == std::end(topics_)) {
-    auto insert_topic =
-      database_->prepare_statement(
-      "INSERT INTO topics (name, type, serialization_format) VALUES (?, ?, ?)");
-    insert_topic->bind(topic.name, topic.type, topic.serialization_format);
-    insert_topic->execute_and_reset();
-    topics_.emplace(topic.name, static_cast<int>(database_->get_last_insert_id()));
+  database_->prepare_statement(
+    "CREATE INDEX IF NOT EXISTS timestamp_idx ON messages (timestamp ASC);")->execute_and_reset();
+  database_->prepare_statement(
+    "CREATE INDEX IF NOT EXISTS topic_timestamp_idx ON messages (topic_id, timestamp ASC);")
+  ->execute_and_reset();
+  are_indices_pending_ = false;
+}
+
+void SqliteStorage::drop_indices()
+{
+  database_->prepare_statement("DROP INDEX IF EXISTS timestamp_idx;")->execute_and_reset();
+  database_->prepare_statement("DROP INDEX IF EXISTS topic_timestamp_idx;")->execute_and_reset();
+  are_indices_pending_ = true;
+}
+
+rosbag2_storage::TopicId SqliteStorage::create_topic(const rosbag2_storage::TopicMetadata & topic)
+{
+  auto topic_entry = topics_.find(topic.name);
+  if (topic_entry != std::end(topics_)) {
+    return topic_entry->second;
   }
+
+  auto insert_topic =
+    database_->prepare_statement(
+    "INSERT INTO topics (name, type, serialization_format) VALUES (?, ?, ?)");
+  insert_topic->bind(topic.name, topic.type, topic.serialization_format);
+  insert_topic->execute_and_reset();
+  auto topic_id = static_cast<int>(database_->get_last_insert_id());
+  topics_.emplace(topic.name, topic_id);
+  topic_names_.emplace(topic_id, topic.name);
+  return topic_id;
 }
 
 void SqliteStorage::remove_topic(const rosbag2_storage::TopicMetadata & topic)
@@ -179,6 +326,15 @@ void SqliteStorage::remove_topic(const rosbag2_storage::TopicMetadata & topic)
       "DELETE FROM topics where name = ? and type = ? and serialization_format = ?");
     delete_topic->bind(topic.name, topic.type, topic.serialization_format);
     delete_topic->execute_and_reset();
+
+    int topic_id = topics_[topic.name];
+    auto delete_statistics =
+      database_->prepare_statement("DELETE FROM topic_statistics where topic_id = ?");
+    delete_statistics->bind(topic_id);
+    delete_statistics->execute_and_reset();
+    topic_statistics_.erase(topic_id);
+    changed_topic_statistics_.erase(topic_id);
+    topic_names_.erase(topic_id);
     topics_.erase(topic.name);
   }
 }
@@ -187,19 +343,164 @@ void SqliteStorage::prepare_for_writing()
 {
   write_statement_ = database_->prepare_statement(
     "INSERT INTO messages (timestamp, topic_id, data) VALUES (?, ?, ?);");
+  begin_transaction_statement_ = database_->prepare_statement("BEGIN TRANSACTION;");
+  commit_transaction_statement_ = database_->prepare_statement("COMMIT;");
+  write_statistics_statement_ = database_->prepare_statement(
+    "INSERT OR REPLACE INTO topic_statistics "
+    "(topic_id, message_count, min_timestamp, max_timestamp, total_bytes) "
+    "VALUES (?, ?, ?, ?, ?);");
+}
+
+void SqliteStorage::begin_write_transaction()
+{
+  begin_transaction_statement_->execute_and_reset();
+  is_transaction_open_ = true;
+  messages_in_transaction_ = 0;
+  bytes_in_transaction_ = 0;
+  transaction_start_time_ = std::chrono::steady_clock::now();
+}
+
+void SqliteStorage::commit_write_transaction()
+{
+  write_topic_statistics();
+  commit_transaction_statement_->execute_and_reset();
+  is_transaction_open_ = false;
+}
+
+bool SqliteStorage::is_write_transaction_limit_reached() const
+{
+  if (transaction_limits_.max_messages > 0 &&
+    messages_in_transaction_ >= transaction_limits_.max_messages)
+  {
+    return true;
+  }
+  if (transaction_limits_.max_bytes > 0 &&
+    bytes_in_transaction_ >= transaction_limits_.max_bytes)
+  {
+    return true;
+  }
+  return transaction_limits_.max_duration.count() > 0 &&
+         std::chrono::steady_clock::now() - transaction_start_time_ >=
+         transaction_limits_.max_duration;
+}
+
+void SqliteStorage::update_topic_statistics(
+  int topic_id, const rosbag2_storage::SerializedBagMessage & message)
+{
+  auto & statistics = topic_statistics_[topic_id];
+  ++statistics.message_count;
+  statistics.min_timestamp = std::min(statistics.min_timestamp, message.time_stamp);
+  statistics.max_timestamp = std::max(statistics.max_timestamp, message.time_stamp);
+  statistics.total_bytes += static_cast<int64_t>(message.serialized_data->buffer_length);
+  changed_topic_statistics_.insert(topic_id);
+}
+
+void SqliteStorage::write_topic_statistics()
+{
+  for (auto topic_id : changed_topic_statistics_) {
+    const auto & statistics = topic_statistics_[topic_id];
+    write_statistics_statement_->bind(
+      topic_id, statistics.message_count, statistics.min_timestamp, statistics.max_timestamp,
+      statistics.total_bytes);
+    write_statistics_statement_->execute_and_reset();
+  }
+  changed_topic_statistics_.clear();
+}
+
+bool SqliteStorage::has_topic_statistics() const
+{
+  auto statement = database_->prepare_statement(
+    "SELECT COUNT(*) FROM sqlite_master WHERE type = 'table' AND name = 'topic_statistics';");
+  return std::get<0>(statement->execute_query<int>().get_single_line()) > 0;
+}
+
+double SqliteStorage::get_message_share(const std::vector<int> & topic_ids) const
+{
+  if (!has_topic_statistics()) {
+    // Bags without statistics are assumed to hold as many messages on each topic
+    return topic_names_.empty() ?
+           0.0 : static_cast<double>(topic_ids.size()) / static_cast<double>(topic_names_.size());
+  }
+
+  auto statement = database_->prepare_statement(
+    "SELECT topic_id, message_count FROM topic_statistics;");
+  int64_t message_count = 0;
+  int64_t filtered_message_count = 0;
+  for (auto result : statement->execute_query<int, int64_t>()) {
+    message_count += std::get<1>(result);
+    if (std::find(topic_ids.begin(), topic_ids.end(), std::get<0>(result)) != topic_ids.end()) {
+      filtered_message_count += std::get<1>(result);
+    }
+  }
+  return message_count == 0 ?
+         0.0 : static_cast<double>(filtered_message_count) / static_cast<double>(message_count);
 }
 
 void SqliteStorage::prepare_for_reading()
 {
-  read_statement_ = database_->prepare_statement(
-    "SELECT data, timestamp, topics.name "
-    "FROM messages JOIN topics ON messages.topic_id = topics.id "
-    "ORDER BY messages.timestamp;");
+  if (are_indices_pending_) {
+    create_indices();
+  }
+  fill_topic_names();
+
+  std::vector<int> filtered_topic_ids;
+  for (const auto & topic : topic_names_) {
+    const auto & topics = storage_filter_.topics;
+    if (std::find(topics.begin(), topics.end(), topic.second) != topics.end()) {
+      filtered_topic_ids.push_back(topic.first);
+    }
+  }
+
+  // Topic names are resolved in memory, which spares joining the topics table for every row.
+  // The data is not selected but read per row into pooled buffers, which spares a copy.
+  // Messages are ordered by timestamp and id, so reading can continue after the last one read.
+  std::string query =
+    "SELECT id, timestamp, topic_id FROM messages WHERE (timestamp, id) > (?, ?)";
+  if (!storage_filter_.topics.empty()) {
+    // Merging several topics from topic_timestamp_idx sorts all of their remaining messages before
+    // the first one is returned. For a large share, the unary + makes SQLite scan timestamp_idx
+    // instead, which is in order already and skips the messages of the other topics.
+    query += filtered_topic_ids.size() > 1 &&
+      get_message_share(filtered_topic_ids) >= max_share_read_by_topic ?
+      " AND +topic_id IN (" : " AND topic_id IN (";
+    for (size_t i = 0; i < filtered_topic_ids.size(); ++i) {
+      query += i == 0 ? "?" : ", ?";
+    }
+    query += ")";
+  }
+  query += " ORDER BY timestamp, id;";
+
+  read_statement_ = database_->prepare_statement(query);
+  read_statement_->bind(std::get<0>(read_position_), std::get<1>(read_position_));
+  for (auto topic_id : filtered_topic_ids) {
+    read_statement_->bind(topic_id);
+  }
   message_result_ = read_statement_->execute_query<
-    std::shared_ptr<rcutils_uint8_array_t>, rcutils_time_point_value_t, std::string>();
+    int64_t, rcutils_time_point_value_t, int>();
+  blob_reader_ = database_->open_blob_reader("messages", "data", message_pool_);
   current_message_row_ = message_result_.begin();
 }
 
+void SqliteStorage::fill_topic_names()
+{
+  auto statement = database_->prepare_statement("SELECT id, name FROM topics;");
+  auto query_results = statement->execute_query<int, std::string>();
+
+  topic_names_.clear();
+  for (auto result : query_results) {
+    topic_names_.emplace(std::get<0>(result), std::get<1>(result));
+  }
+}
+
+const std::string & SqliteStorage::get_topic_name(int topic_id) const
+{
+  auto topic_entry = topic_names_.find(topic_id);
+  if (topic_entry == std::end(topic_names_)) {
+    throw SqliteException("Message refers to unknown topic id " + std::to_string(topic_id) + ".");
+  }
+  return topic_entry->second;
+}
+
 void SqliteStorage::fill_topics_and_types()
 {
   auto statement = database_->prepare_statement(
@@ -247,7 +548,18 @@ rosbag2_storage::BagMetadata SqliteStorage::get_metadata()
   metadata.message_count = 0;
   metadata.topics_with_message_count = {};
 
-  auto statement = database_->prepare_statement(
+  if (is_transaction_open_) {
+    // The open transaction is visible to this connection, so its statistics have to be as well
+    write_topic_statistics();
+  }
+
+  // Bags written before the statistics table was introduced fall back to scanning all messages
+  auto statement = has_topic_statistics() ?
+    database_->prepare_statement(
+    "SELECT name, type, serialization_format, message_count, min_timestamp, max_timestamp "
+    "FROM topic_statistics JOIN topics on topics.id = topic_statistics.topic_id "
+    "ORDER BY topics.name;") :
+    database_->prepare_statement(
     "SELECT name, type, serialization_format, COUNT(messages.id), MIN(messages.timestamp), "
     "MAX(messages.timestamp) "
     "FROM messages JOIN topics on topics.id = messages.topic_id "
@@ -69,6 +69,13 @@ SqliteStatement SqliteWrapper::prepare_statement(const std::string & query)
   return std::make_shared<SqliteStatementWrapper>(db_ptr, query);
 }
 
+SqliteBlobReaderPtr SqliteWrapper::open_blob_reader(
+  const std::string & table, const std::string & column,
+  std::shared_ptr<rosbag2_storage::SerializedMessagePool> message_pool)
+{
+  return std::make_shared<SqliteBlobReader>(db_ptr, table, column, message_pool);
+}
+
 size_t SqliteWrapper::get_last_insert_id()
 {
   return sqlite3_last_insert_rowid(db_ptr);
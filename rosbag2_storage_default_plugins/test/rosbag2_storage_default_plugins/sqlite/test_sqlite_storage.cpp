@@ -14,6 +14,8 @@
 
 #include <gmock/gmock.h>
 
+#include <algorithm>
+#include <chrono>
 #include <memory>
 #include <string>
 #include <tuple>
@@ -23,6 +25,8 @@
 #include "rcutils/snprintf.h"
 
 #include "rosbag2_storage/filesystem_helper.hpp"
+#include "rosbag2_storage_default_plugins/sqlite/sqlite_exception.hpp"
+#include "rosbag2_storage_default_plugins/sqlite/sqlite_wrapper.hpp"
 #include "storage_test_fixture.hpp"
 
 using namespace ::testing;  // NOLINT
@@ -68,6 +72,22 @@ TEST_F(StorageTestFixture, string_messages_are_written_and_read_to_and_from_sqli
   }
 }
 
+TEST_F(StorageTestFixture, messages_spanning_several_database_pages_are_read_completely) {
+  std::string big_message(100000, 'x');
+  std::vector<std::tuple<std::string, int64_t, std::string, std::string, std::string>> messages =
+  {std::make_tuple(big_message, 1, "topic", "type", "rmw"),
+    std::make_tuple("small message", 2, "topic", "type", "rmw"),
+    std::make_tuple(big_message, 3, "topic", "type", "rmw")};
+
+  write_messages_to_sqlite(messages);
+  auto read_messages = read_all_messages_from_sqlite();
+
+  ASSERT_THAT(read_messages, SizeIs(3));
+  EXPECT_THAT(deserialize_message(read_messages[0]->serialized_data), Eq(big_message));
+  EXPECT_THAT(deserialize_message(read_messages[1]->serialized_data), Eq("small message"));
+  EXPECT_THAT(deserialize_message(read_messages[2]->serialized_data), Eq(big_message));
+}
+
 TEST_F(StorageTestFixture, has_next_return_false_if_there_are_no_more_messages) {
   std::vector<std::tuple<std::string, int64_t, std::string, std::string, std::string>>
   string_messages =
@@ -106,6 +126,180 @@ TEST_F(StorageTestFixture, get_next_returns_messages_in_timestamp_order) {
   EXPECT_FALSE(readable_storage->has_next());
 }
 
+TEST_F(StorageTestFixture, read_next_returns_filtered_messages) {
+  std::vector<std::tuple<std::string, int64_t, std::string, std::string, std::string>>
+  string_messages =
+  {std::make_tuple("topic1 message", 1, "topic1", "", ""),
+    std::make_tuple("topic2 message", 2, "topic2", "", ""),
+    std::make_tuple("topic3 message", 3, "topic3", "", ""),
+    std::make_tuple("topic1 message", 4, "topic1", "", "")};
+
+  write_messages_to_sqlite(string_messages);
+  std::unique_ptr<rosbag2_storage::storage_interfaces::ReadOnlyInterface> readable_storage =
+    std::make_unique<rosbag2_storage_plugins::SqliteStorage>();
+  readable_storage->open(temporary_dir_path_);
+
+  rosbag2_storage::StorageFilter storage_filter;
+  storage_filter.topics = {"topic1", "topic3"};
+  readable_storage->set_filter(storage_filter);
+
+  std::vector<int64_t> read_timestamps;
+  while (readable_storage->has_next()) {
+    auto message = readable_storage->read_next();
+    EXPECT_THAT(message->topic_name, AnyOf(Eq("topic1"), Eq("topic3")));
+    read_timestamps.push_back(message->time_stamp);
+  }
+  EXPECT_THAT(read_timestamps, ElementsAre(1, 3, 4));
+}
+
+TEST_F(StorageTestFixture, changed_filter_applies_to_messages_not_yet_read) {
+  std::vector<std::tuple<std::string, int64_t, std::string, std::string, std::string>>
+  string_messages =
+  {std::make_tuple("topic1 message", 1, "topic1", "", ""),
+    std::make_tuple("topic2 message", 2, "topic2", "", ""),
+    std::make_tuple("topic1 message", 3, "topic1", "", ""),
+    std::make_tuple("topic2 message", 4, "topic2", "", "")};
+
+  write_messages_to_sqlite(string_messages);
+  std::unique_ptr<rosbag2_storage::storage_interfaces::ReadOnlyInterface> readable_storage =
+    std::make_unique<rosbag2_storage_plugins::SqliteStorage>();
+  readable_storage->open(temporary_dir_path_);
+
+  rosbag2_storage::StorageFilter storage_filter;
+  storage_filter.topics = {"topic2"};
+  readable_storage->set_filter(storage_filter);
+  ASSERT_TRUE(readable_storage->has_next());
+  EXPECT_THAT(readable_storage->read_next()->time_stamp, Eq(2));
+
+  readable_storage->reset_filter();
+  ASSERT_TRUE(readable_storage->has_next());
+  EXPECT_THAT(readable_storage->read_next()->time_stamp, Eq(3));
+  ASSERT_TRUE(readable_storage->has_next());
+  EXPECT_THAT(readable_storage->read_next()->time_stamp, Eq(4));
+  EXPECT_FALSE(readable_storage->has_next());
+}
+
+TEST_F(StorageTestFixture, filter_with_unknown_topics_returns_no_messages) {
+  std::vector<std::tuple<std::string, int64_t, std::string, std::string, std::string>>
+  string_messages = {std::make_tuple("topic1 message", 1, "topic1", "", "")};
+
+  write_messages_to_sqlite(string_messages);
+  std::unique_ptr<rosbag2_storage::storage_interfaces::ReadOnlyInterface> readable_storage =
+    std::make_unique<rosbag2_storage_plugins::SqliteStorage>();
+  readable_storage->open(temporary_dir_path_);
+
+  rosbag2_storage::StorageFilter storage_filter;
+  storage_filter.topics = {"unknown_topic"};
+  readable_storage->set_filter(storage_filter);
+
+  EXPECT_FALSE(readable_storage->has_next());
+}
+
+TEST_F(StorageTestFixture, seek_continues_reading_at_the_given_timestamp) {
+  std::vector<std::tuple<std::string, int64_t, std::string, std::string, std::string>>
+  string_messages =
+  {std::make_tuple("first message", 2, "topic1", "", ""),
+    std::make_tuple("second message", 4, "topic2", "", ""),
+    std::make_tuple("third message", 6, "topic1", "", ""),
+    std::make_tuple("fourth message", 8, "topic2", "", "")};
+
+  write_messages_to_sqlite(string_messages);
+  std::unique_ptr<rosbag2_storage::storage_interfaces::ReadOnlyInterface> readable_storage =
+    std::make_unique<rosbag2_storage_plugins::SqliteStorage>();
+  readable_storage->open(temporary_dir_path_);
+
+  readable_storage->seek(5);
+  ASSERT_TRUE(readable_storage->has_next());
+  EXPECT_THAT(readable_storage->read_next()->time_stamp, Eq(6));
+
+  readable_storage->seek(4);
+  ASSERT_TRUE(readable_storage->has_next());
+  EXPECT_THAT(readable_storage->read_next()->time_stamp, Eq(4));
+
+  rosbag2_storage::StorageFilter storage_filter;
+  storage_filter.topics = {"topic1"};
+  readable_storage->set_filter(storage_filter);
+  readable_storage->seek(0);
+  ASSERT_TRUE(readable_storage->has_next());
+  EXPECT_THAT(readable_storage->read_next()->time_stamp, Eq(2));
+  ASSERT_TRUE(readable_storage->has_next());
+  EXPECT_THAT(readable_storage->read_next()->time_stamp, Eq(6));
+  EXPECT_FALSE(readable_storage->has_next());
+
+  readable_storage->seek(10);
+  EXPECT_FALSE(readable_storage->has_next());
+}
+
+TEST_F(StorageTestFixture, seek_returns_messages_in_order_for_filters_on_few_and_many_messages) {
+  std::vector<std::tuple<std::string, int64_t, std::string, std::string, std::string>>
+  string_messages;
+  for (int64_t timestamp = 1; timestamp <= 100; ++timestamp) {
+    // topic1 and topic2 hold a single message each, topic3 and topic4 share the others
+    auto topic = timestamp == 50 ? "topic1" : timestamp == 60 ? "topic2" :
+      timestamp % 2 == 0 ? "topic3" : "topic4";
+    string_messages.push_back(std::make_tuple("message", 101 - timestamp, topic, "", ""));
+  }
+
+  write_messages_to_sqlite(string_messages);
+  std::unique_ptr<rosbag2_storage::storage_interfaces::ReadOnlyInterface> readable_storage =
+    std::make_unique<rosbag2_storage_plugins::SqliteStorage>();
+  readable_storage->open(temporary_dir_path_);
+  auto read_timestamps = [&readable_storage]() {
+      std::vector<int64_t> timestamps;
+      while (readable_storage->has_next()) {
+        timestamps.push_back(readable_storage->read_next()->time_stamp);
+      }
+      return timestamps;
+    };
+
+  rosbag2_storage::StorageFilter storage_filter;
+  storage_filter.topics = {"topic1", "topic3"};
+  readable_storage->set_filter(storage_filter);
+  readable_storage->seek(40);
+  auto timestamps = read_timestamps();
+  EXPECT_THAT(timestamps, SizeIs(29));
+  EXPECT_THAT(timestamps.front(), Eq(43));
+  EXPECT_TRUE(std::is_sorted(timestamps.begin(), timestamps.end()));
+
+  storage_filter.topics = {"topic1", "topic2"};
+  readable_storage->set_filter(storage_filter);
+  readable_storage->seek(40);
+  EXPECT_THAT(read_timestamps(), ElementsAre(41, 51));
+}
+
+TEST_F(StorageTestFixture, set_read_position_continues_after_the_message_read_there) {
+  std::vector<std::tuple<std::string, int64_t, std::string, std::string, std::string>>
+  string_messages =
+  {std::make_tuple("first message", 2, "topic1", "", ""),
+    std::make_tuple("second message", 2, "topic2", "", ""),
+    std::make_tuple("third message", 2, "topic1", "", "")};
+
+  write_messages_to_sqlite(string_messages);
+  std::unique_ptr<rosbag2_storage::storage_interfaces::ReadOnlyInterface> readable_storage =
+    std::make_unique<rosbag2_storage_plugins::SqliteStorage>();
+  readable_storage->open(temporary_dir_path_);
+
+  readable_storage->read_next();
+  auto read_position = readable_storage->get_read_position();
+  EXPECT_THAT(read_position.time_stamp, Eq(2));
+  readable_storage->read_next();
+
+  rosbag2_storage::StorageFilter storage_filter;
+  storage_filter.topics = {"topic1"};
+  readable_storage->set_filter(storage_filter);
+  readable_storage->set_read_position(read_position);
+  ASSERT_TRUE(readable_storage->has_next());
+  EXPECT_THAT(
+    deserialize_message(readable_storage->read_next()->serialized_data), Eq("third message"));
+  EXPECT_FALSE(readable_storage->has_next());
+
+  readable_storage->reset_filter();
+  readable_storage->set_read_position(read_position);
+  ASSERT_TRUE(readable_storage->has_next());
+  EXPECT_THAT(
+    deserialize_message(readable_storage->read_next()->serialized_data), Eq("second message"));
+}
+
 TEST_F(StorageTestFixture, get_all_topics_and_types_returns_the_correct_vector) {
   std::unique_ptr<rosbag2_storage::storage_interfaces::ReadWriteInterface> writable_storage =
     std::make_unique<rosbag2_storage_plugins::SqliteStorage>();
@@ -199,3 +393,202 @@ TEST_F(StorageTestFixture, remove_topics_and_types_returns_the_empty_vector) {
 
   EXPECT_THAT(topics_and_types, IsEmpty());
 }
+
+TEST_F(StorageTestFixture, messages_are_committed_in_groups_and_on_destruction) {
+  rosbag2_storage_plugins::WriteTransactionLimits transaction_limits;
+  transaction_limits.max_messages = 2;
+  transaction_limits.max_bytes = 0;
+  transaction_limits.max_duration = std::chrono::milliseconds(0);
+  auto writable_storage =
+    std::make_unique<rosbag2_storage_plugins::SqliteStorage>(transaction_limits);
+  writable_storage->open(temporary_dir_path_);
+  writable_storage->create_topic({"topic1", "type1", "rmw1"});
+  for (int64_t i = 1; i <= 3; ++i) {
+    auto bag_message = std::make_shared<rosbag2_storage::SerializedBagMessage>();
+    bag_message->serialized_data = make_serialized_message("message " + std::to_string(i));
+    bag_message->time_stamp = i;
+    bag_message->topic_name = "topic1";
+    writable_storage->write(bag_message);
+  }
+
+  auto database_path = rosbag2_storage::FilesystemHelper::concat({temporary_dir_path_,
+      rosbag2_storage::FilesystemHelper::get_folder_name(temporary_dir_path_) + ".db3"});
+  auto count_committed_messages = [&database_path]() {
+      rosbag2_storage_plugins::SqliteWrapper reader(
+        database_path, rosbag2_storage::storage_interfaces::IOFlag::READ_ONLY);
+      return std::get<0>(reader.prepare_statement("SELECT COUNT(*) FROM messages;")
+             ->execute_query<int>().get_single_line());
+    };
+
+  EXPECT_THAT(count_committed_messages(), Eq(2));
+  writable_storage.reset();
+  EXPECT_THAT(count_committed_messages(), Eq(3));
+}
+
+TEST_F(StorageTestFixture, write_batch_limits_can_be_set_after_construction) {
+  rosbag2_storage::WriteBatchLimits write_batch_limits;
+  write_batch_limits.max_messages = 1;
+  write_batch_limits.max_duration = std::chrono::milliseconds(0);
+  auto writable_storage = std::make_unique<rosbag2_storage_plugins::SqliteStorage>();
+  writable_storage->set_write_batch_limits(write_batch_limits);
+  writable_storage->open(temporary_dir_path_);
+  writable_storage->create_topic({"topic1", "type1", "rmw1"});
+  auto bag_message = std::make_shared<rosbag2_storage::SerializedBagMessage>();
+  bag_message->serialized_data = make_serialized_message("message");
+  bag_message->time_stamp = 1;
+  bag_message->topic_name = "topic1";
+  writable_storage->write(bag_message);
+
+  auto database_path = rosbag2_storage::FilesystemHelper::concat({temporary_dir_path_,
+      rosbag2_storage::FilesystemHelper::get_folder_name(temporary_dir_path_) + ".db3"});
+  rosbag2_storage_plugins::SqliteWrapper reader(
+    database_path, rosbag2_storage::storage_interfaces::IOFlag::READ_ONLY);
+  EXPECT_THAT(std::get<0>(reader.prepare_statement("SELECT COUNT(*) FROM messages;")
+    ->execute_query<int>().get_single_line()), Eq(1));
+}
+
+TEST_F(StorageTestFixture, indices_are_created_on_destruction_if_deferred) {
+  auto database_path = rosbag2_storage::FilesystemHelper::concat({temporary_dir_path_,
+      rosbag2_storage::FilesystemHelper::get_folder_name(temporary_dir_path_) + ".db3"});
+  auto count_indices = [&database_path]() {
+      rosbag2_storage_plugins::SqliteWrapper reader(
+        database_path, rosbag2_storage::storage_interfaces::IOFlag::READ_ONLY);
+      return std::get<0>(reader.prepare_statement(
+               "SELECT COUNT(*) FROM sqlite_master WHERE type = 'index';")
+             ->execute_query<int>().get_single_line());
+    };
+
+  auto writable_storage = std::make_unique<rosbag2_storage_plugins::SqliteStorage>(
+    rosbag2_storage_plugins::WriteTransactionLimits(),
+    rosbag2_storage_plugins::IndexCreation::AFTER_WRITING);
+  writable_storage->open(temporary_dir_path_);
+  writable_storage->create_topic({"topic1", "type1", "rmw1"});
+  auto bag_message = std::make_shared<rosbag2_storage::SerializedBagMessage>();
+  bag_message->serialized_data = make_serialized_message("message");
+  bag_message->time_stamp = 1;
+  bag_message->topic_name = "topic1";
+  writable_storage->write(bag_message);
+
+  EXPECT_THAT(count_indices(), Eq(0));
+  writable_storage.reset();
+  EXPECT_THAT(count_indices(), Eq(2));
+}
+
+TEST_F(StorageTestFixture, indices_are_created_before_writing_unless_deferred_after_open) {
+  auto database_path = rosbag2_storage::FilesystemHelper::concat({temporary_dir_path_,
+      rosbag2_storage::FilesystemHelper::get_folder_name(temporary_dir_path_) + ".db3"});
+  auto count_indices = [&database_path]() {
+      rosbag2_storage_plugins::SqliteWrapper reader(
+        database_path, rosbag2_storage::storage_interfaces::IOFlag::READ_ONLY);
+      return std::get<0>(reader.prepare_statement(
+               "SELECT COUNT(*) FROM sqlite_master WHERE type = 'index';")
+             ->execute_query<int>().get_single_line());
+    };
+
+  auto writable_storage = std::make_unique<rosbag2_storage_plugins::SqliteStorage>();
+  writable_storage->open(temporary_dir_path_);
+  EXPECT_THAT(count_indices(), Eq(2));
+
+  writable_storage->set_index_creation(rosbag2_storage::IndexCreation::AFTER_WRITING);
+  EXPECT_THAT(count_indices(), Eq(0));
+  writable_storage.reset();
+  EXPECT_THAT(count_indices(), Eq(2));
+}
+
+TEST_F(StorageTestFixture, indices_are_created_before_writing_if_requested) {
+  auto database_path = rosbag2_storage::FilesystemHelper::concat({temporary_dir_path_,
+      rosbag2_storage::FilesystemHelper::get_folder_name(temporary_dir_path_) + ".db3"});
+
+  auto writable_storage = std::make_unique<rosbag2_storage_plugins::SqliteStorage>(
+    rosbag2_storage_plugins::WriteTransactionLimits(),
+    rosbag2_storage_plugins::IndexCreation::BEFORE_WRITING);
+  writable_storage->open(temporary_dir_path_);
+
+  rosbag2_storage_plugins::SqliteWrapper reader(
+    database_path, rosbag2_storage::storage_interfaces::IOFlag::READ_ONLY);
+  EXPECT_THAT(std::get<0>(reader.prepare_statement(
+      "SELECT COUNT(*) FROM sqlite_master WHERE type = 'index';")
+    ->execute_query<int>().get_single_line()), Eq(2));
+}
+
+TEST_F(StorageTestFixture, topic_statistics_are_written_with_each_transaction) {
+  auto database_path = rosbag2_storage::FilesystemHelper::concat({temporary_dir_path_,
+      rosbag2_storage::FilesystemHelper::get_folder_name(temporary_dir_path_) + ".db3"});
+  rosbag2_storage_plugins::WriteTransactionLimits transaction_limits;
+  transaction_limits.max_messages = 2;
+  auto writable_storage =
+    std::make_unique<rosbag2_storage_plugins::SqliteStorage>(transaction_limits);
+  writable_storage->open(temporary_dir_path_);
+  writable_storage->create_topic({"topic1", "type1", "rmw1"});
+
+  for (auto timestamp : {3, 1, 2}) {
+    auto bag_message = std::make_shared<rosbag2_storage::SerializedBagMessage>();
+    bag_message->serialized_data = make_serialized_message("message");
+    bag_message->time_stamp = timestamp;
+    bag_message->topic_name = "topic1";
+    writable_storage->write(bag_message);
+  }
+
+  rosbag2_storage_plugins::SqliteWrapper reader(
+    database_path, rosbag2_storage::storage_interfaces::IOFlag::READ_ONLY);
+  auto read_statistics = [&reader]() {
+      return reader.prepare_statement(
+        "SELECT message_count, min_timestamp, max_timestamp FROM topic_statistics;")
+             ->execute_query<int, rcutils_time_point_value_t, rcutils_time_point_value_t>()
+             .get_single_line();
+    };
+
+  EXPECT_THAT(read_statistics(), Eq(std::make_tuple(2, 1, 3)));
+  writable_storage.reset();
+  EXPECT_THAT(read_statistics(), Eq(std::make_tuple(3, 1, 3)));
+}
+
+TEST_F(StorageTestFixture, get_metadata_counts_messages_of_bags_without_topic_statistics) {
+  std::vector<std::tuple<std::string, int64_t, std::string, std::string, std::string>> messages =
+  {std::make_tuple("first message", 1, "topic1", "type1", "rmw_format"),
+    std::make_tuple("second message", 2, "topic2", "type2", "rmw_format"),
+    std::make_tuple("third message", 3, "topic1", "type1", "rmw_format")};
+  write_messages_to_sqlite(messages);
+
+  auto database_path = rosbag2_storage::FilesystemHelper::concat({temporary_dir_path_,
+      rosbag2_storage::FilesystemHelper::get_folder_name(temporary_dir_path_) + ".db3"});
+  rosbag2_storage_plugins::SqliteWrapper(
+    database_path, rosbag2_storage::storage_interfaces::IOFlag::READ_WRITE)
+  .prepare_statement("DROP TABLE topic_statistics;")->execute_and_reset();
+
+  auto readable_storage = std::make_unique<rosbag2_storage_plugins::SqliteStorage>();
+  readable_storage->open(
+    temporary_dir_path_, rosbag2_storage::storage_interfaces::IOFlag::READ_ONLY);
+  auto metadata = readable_storage->get_metadata();
+
+  EXPECT_THAT(metadata.topics_with_message_count, ElementsAreArray({
+    rosbag2_storage::TopicInformation{rosbag2_storage::TopicMetadata{
+        "topic1", "type1", "rmw_format"}, 2u},
+    rosbag2_storage::TopicInformation{rosbag2_storage::TopicMetadata{
+        "topic2", "type2", "rmw_format"}, 1u}
+  }));
+  EXPECT_THAT(metadata.message_count, Eq(3u));
+  EXPECT_THAT(metadata.duration, Eq(std::chrono::nanoseconds(2)));
+}
+
+TEST_F(StorageTestFixture, messages_written_by_topic_id_are_read_with_topic_name) {
+  std::unique_ptr<rosbag2_storage::storage_interfaces::ReadWriteInterface> writable_storage =
+    std::make_unique<rosbag2_storage_plugins::SqliteStorage>();
+  writable_storage->open(temporary_dir_path_);
+  auto topic_id = writable_storage->create_topic({"topic1", "type1", "rmw1"});
+  EXPECT_THAT(writable_storage->create_topic({"topic1", "type1", "rmw1"}), Eq(topic_id));
+
+  auto bag_message = std::make_shared<rosbag2_storage::SerializedBagMessage>();
+  bag_message->serialized_data = make_serialized_message("message");
+  bag_message->time_stamp = 1;
+  writable_storage->write(topic_id, bag_message);
+  EXPECT_THROW(writable_storage->write(topic_id + 1, bag_message),
+    rosbag2_storage_plugins::SqliteException);
+  metadata_io_.write_metadata(temporary_dir_path_, writable_storage->get_metadata());
+  writable_storage.reset();
+
+  auto read_messages = read_all_messages_from_sqlite();
+  ASSERT_THAT(read_messages, SizeIs(1));
+  EXPECT_THAT(read_messages[0]->topic_name, Eq("topic1"));
+  EXPECT_THAT(deserialize_message(read_messages[0]->serialized_data), Eq("message"));
+}
@@ -18,6 +18,8 @@ cd ./build/bin
 ./small_messages_benchmark
 ./big_messages_benchmark
 ./mixed_messages_benchmark
+./read_query_benchmark
+./seek_benchmark
 
 cd ../..
 
@@ -0,0 +1,128 @@
+/*
+ *  Copyright (c) 2018,  Bosch Software Innovations GmbH.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <utility>
+
+#include "benchmark/reader/sqlite/sqlite_reader_benchmark.h"
+#include "generators/message_generator.h"
+#include "profiler/profiler.h"
+#include "reader/sqlite/sqlite_message_stream.h"
+#include "writer/sqlite/separate_topic_table_sqlite_writer.h"
+
+using namespace ros2bag;
+
+void write_bag(
+  std::string const & db_name,
+  unsigned int loop_count,
+  unsigned int number_of_topics,
+  unsigned int message_blob_size,
+  unsigned int transaction_size)
+{
+  MessageGenerator::Specification specification;
+  for (auto i = 0u; i < number_of_topics; ++i) {
+    specification.emplace_back("topic/" + std::to_string(i), message_blob_size);
+  }
+  MessageGenerator generator(loop_count, specification);
+
+  SeparateTopicTableSqliteWriter writer(
+    db_name,
+    transaction_size,
+    Indices({{"MESSAGES", "TIMESTAMP"}}),
+    Pragmas({{"journal_mode", "MEMORY"},
+             {"synchronous",  "OFF"}}));
+
+  std::remove(db_name.c_str());
+  writer.open();
+  while (generator.has_next()) {
+    writer.write(generator.next());
+  }
+  writer.create_index();
+  writer.close();
+}
+
+void run_benchmark_repeatedly(
+  unsigned int times,
+  std::string const & description,
+  SqliteReaderBenchmark::StreamFactory const & stream_factory,
+  std::string const & db_name,
+  unsigned long number_of_messages,
+  unsigned int number_of_topics,
+  unsigned int message_blob_size,
+  bool with_header = false)
+{
+  std::vector<std::pair<std::string, std::string>> meta_data = {
+    {"description",               description},
+    {"number of messages",        std::to_string(number_of_messages)},
+    {"number of topics",          std::to_string(number_of_topics)},
+    {"message blob size (bytes)", std::to_string(message_blob_size)}
+  };
+
+  for (int i = 0; i < times; ++i) {
+    SqliteReaderBenchmark benchmark(
+      db_name,
+      number_of_messages,
+      stream_factory,
+      std::make_unique<Profiler>(meta_data, db_name));
+
+    benchmark.run();
+
+    write_csv_file("read_query_benchmark.csv", benchmark, with_header);
+    with_header = false;
+  }
+}
+
+int main(int argc, char ** argv)
+{
+  /**
+   * We compare reading with a join on the topics table against reading topic ids only and
+   * resolving the names from memory. The bag contains 1M small messages, roughly 180MB.
+   */
+  std::string db_name = "read_query_benchmark.db";
+  unsigned int const number_of_topics = 100;
+  unsigned int const message_blob_size = 128;
+  unsigned int const loop_count = 10000;
+  unsigned int const transaction_size = 10000;
+  unsigned long const number_of_messages =
+    static_cast<unsigned long>(loop_count) * number_of_topics;
+
+  auto const write_header = true;
+
+  write_bag(db_name, loop_count, number_of_topics, message_blob_size, transaction_size);
+
+  run_benchmark_repeatedly(5,
+    "JoinedTopicQuery",
+    [](sqlite::DBPtr db) {
+      return std::make_unique<JoinedTopicSqliteMessageStream>(db);
+    },
+    db_name,
+    number_of_messages,
+    number_of_topics,
+    message_blob_size, write_header);
+
+  run_benchmark_repeatedly(5,
+    "TopicIdQuery",
+    [](sqlite::DBPtr db) {
+      return std::make_unique<TopicIdSqliteMessageStream>(db);
+    },
+    db_name,
+    number_of_messages,
+    number_of_topics,
+    message_blob_size);
+
+  std::remove(db_name.c_str());
+
+  return EXIT_SUCCESS;
+}
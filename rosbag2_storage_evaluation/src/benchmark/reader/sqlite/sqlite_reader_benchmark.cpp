@@ -0,0 +1,59 @@
+/*
+ *  Copyright (c) 2018,  Bosch Software Innovations GmbH.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include "benchmark/reader/sqlite/sqlite_reader_benchmark.h"
+
+using namespace ros2bag;
+
+void SqliteReaderBenchmark::run() const
+{
+  auto db = sqlite::open_db(db_name_);
+
+  profiler_->take_time_for("start reading time");
+
+  auto stream = stream_factory_(db);
+  unsigned long read_msg_count = 0;
+  if (stream->has_next()) {
+    stream->next();
+    ++read_msg_count;
+  }
+
+  profiler_->take_time_for("first message time");
+
+  Profiler::TickProgress throughput_tick = profiler_->measure_progress(
+    "read_throughput", total_msg_count_);
+  throughput_tick();
+
+  while (read_msg_count < total_msg_count_ && stream->has_next()) {
+    stream->next();
+    ++read_msg_count;
+    throughput_tick();
+  }
+
+  profiler_->take_time_for("end reading time");
+
+  stream.reset();
+  sqlite::close_db(db);
+  profiler_->track_disk_usage();
+}
+
+void SqliteReaderBenchmark::write_csv(std::ostream & out_stream, bool with_header) const
+{
+  if (with_header) {
+    out_stream << profiler_->csv_header() << std::endl;
+  }
+  out_stream << profiler_->csv_entry() << std::endl;
+}
@@ -0,0 +1,67 @@
+/*
+ *  Copyright (c) 2018,  Bosch Software Innovations GmbH.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef ROS2_ROSBAG_EVALUATION_SQLITE_READER_BENCHMARK_H
+#define ROS2_ROSBAG_EVALUATION_SQLITE_READER_BENCHMARK_H
+
+#include <functional>
+#include <memory>
+#include <string>
+
+#include "benchmark/benchmark.h"
+#include "profiler/profiler.h"
+#include "reader/message_stream.h"
+#include "writer/sqlite/sqlite.h"
+
+namespace ros2bag
+{
+
+/**
+ * Measures the time until the first message and the throughput of streaming up to the given
+ * number of messages out of an existing database.
+ */
+class SqliteReaderBenchmark : public Benchmark
+{
+public:
+  using StreamFactory = std::function<MessageStream::Ptr(sqlite::DBPtr)>;
+
+  SqliteReaderBenchmark(
+    std::string const & db_name,
+    unsigned long total_msg_count,
+    StreamFactory stream_factory,
+    std::unique_ptr<Profiler> profiler)
+    : db_name_(db_name)
+    , total_msg_count_(total_msg_count)
+    , stream_factory_(std::move(stream_factory))
+    , profiler_(std::move(profiler))
+  {}
+
+  ~SqliteReaderBenchmark() override = default;
+
+  void run() const override;
+
+  void write_csv(std::ostream & out_stream, bool with_header) const override;
+
+private:
+  std::string const db_name_;
+  unsigned long const total_msg_count_;
+  StreamFactory stream_factory_;
+  std::unique_ptr<Profiler> profiler_;
+};
+
+}
+
+#endif //ROS2_ROSBAG_EVALUATION_SQLITE_READER_BENCHMARK_H
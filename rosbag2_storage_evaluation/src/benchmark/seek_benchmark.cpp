@@ -0,0 +1,181 @@
+/*
+ *  Copyright (c) 2018,  Bosch Software Innovations GmbH.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <limits>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "benchmark/reader/sqlite/sqlite_reader_benchmark.h"
+#include "generators/message_generator.h"
+#include "profiler/profiler.h"
+#include "reader/sqlite/sqlite_message_stream.h"
+#include "writer/sqlite/separate_topic_table_sqlite_writer.h"
+
+using namespace ros2bag;
+
+void write_bag(
+  std::string const & db_name,
+  unsigned int loop_count,
+  unsigned int number_of_topics,
+  unsigned int message_blob_size,
+  unsigned int transaction_size)
+{
+  MessageGenerator::Specification specification;
+  for (auto i = 0u; i < number_of_topics; ++i) {
+    specification.emplace_back("topic/" + std::to_string(i), message_blob_size);
+  }
+  MessageGenerator generator(loop_count, specification);
+
+  SeparateTopicTableSqliteWriter writer(
+    db_name,
+    transaction_size,
+    Indices({{"MESSAGES", "TIMESTAMP"}}),
+    Pragmas({{"journal_mode", "MEMORY"},
+             {"synchronous",  "OFF"}}));
+
+  std::remove(db_name.c_str());
+  writer.open();
+  while (generator.has_next()) {
+    writer.write(generator.next());
+  }
+  writer.create_index();
+  writer.close();
+
+  // The indices of rosbag2 bags, timestamp_idx and topic_timestamp_idx, replace the writer's
+  auto db = sqlite::open_db(db_name);
+  sqlite::exec(db, "DROP INDEX IF EXISTS TOPIC_ID_INDEX;");
+  sqlite::exec(db, "CREATE INDEX TOPIC_TIMESTAMP_INDEX ON MESSAGES (TOPIC_ID, TIMESTAMP);");
+  sqlite::close_db(db);
+}
+
+std::pair<Message::Timestamp, Message::Timestamp> get_time_range(std::string const & db_name)
+{
+  auto db = sqlite::open_db(db_name);
+  auto statement = sqlite::new_select_stmt(
+    db, "SELECT MIN(TIMESTAMP), MAX(TIMESTAMP) FROM MESSAGES;");
+  sqlite3_step(statement);
+  auto time_range = std::make_pair(
+    Message::Timestamp(Message::Timestamp::duration(sqlite3_column_int64(statement, 0))),
+    Message::Timestamp(Message::Timestamp::duration(sqlite3_column_int64(statement, 1))));
+  sqlite::finalize(statement);
+  sqlite::close_db(db);
+  return time_range;
+}
+
+std::vector<sqlite3_int64> get_topic_ids(
+  std::string const & db_name, unsigned int number_of_topics)
+{
+  auto db = sqlite::open_db(db_name);
+  auto statement = sqlite::new_select_stmt(db, "SELECT ID FROM TOPICS ORDER BY ID LIMIT ?;");
+  sqlite3_bind_int64(statement, 1, number_of_topics);
+  std::vector<sqlite3_int64> topic_ids;
+  while (sqlite3_step(statement) == SQLITE_ROW) {
+    topic_ids.push_back(sqlite3_column_int64(statement, 0));
+  }
+  sqlite::finalize(statement);
+  sqlite::close_db(db);
+  return topic_ids;
+}
+
+void run_benchmark_repeatedly(
+  unsigned int times,
+  std::string const & db_name,
+  std::string const & description,
+  std::vector<sqlite3_int64> const & topic_ids,
+  bool scan_timestamp_index,
+  unsigned int seek_offset_percentage,
+  Message::Timestamp const & seek_timestamp,
+  unsigned long number_of_messages_to_read,
+  bool with_header = false)
+{
+  std::vector<std::pair<std::string, std::string>> meta_data = {
+    {"description",               description},
+    {"number of filtered topics", std::to_string(topic_ids.size())},
+    {"seek offset (%)",           std::to_string(seek_offset_percentage)},
+    {"number of messages read",   std::to_string(number_of_messages_to_read)}
+  };
+
+  for (int i = 0; i < times; ++i) {
+    SqliteReaderBenchmark benchmark(
+      db_name,
+      number_of_messages_to_read,
+      [seek_timestamp, &topic_ids, scan_timestamp_index](sqlite::DBPtr db) {
+        // Seeking continues before the first message of the timestamp, like SqliteStorage::seek
+        return std::make_unique<StorageQuerySqliteMessageStream>(
+          db, seek_timestamp, std::numeric_limits<sqlite3_int64>::min(), topic_ids,
+          scan_timestamp_index);
+      },
+      std::make_unique<Profiler>(meta_data, db_name));
+
+    benchmark.run();
+
+    write_csv_file("seek_benchmark.csv", benchmark, with_header);
+    with_header = false;
+  }
+}
+
+int main(int argc, char ** argv)
+{
+  /**
+   * We start reading at different points of a bag of 10M small messages, roughly 1.3GB, with the
+   * read query of rosbag2's SqliteStorage. It reads all topics, half of them or a single one.
+   * Half of the topics are read through the topic index, which sorts the remaining messages first,
+   * and with +TOPIC_ID through the timestamp index, as SqliteStorage does for such filters.
+   * Thanks to the timestamp index, the time until the first message should not depend on the seek
+   * offset.
+   */
+  std::string db_name = "seek_benchmark.db";
+  unsigned int const number_of_topics = 100;
+  unsigned int const message_blob_size = 128;
+  unsigned int const loop_count = 100000;
+  unsigned int const transaction_size = 10000;
+  unsigned long const number_of_messages_to_read = 1000;
+
+  auto write_header = true;
+
+  write_bag(db_name, loop_count, number_of_topics, message_blob_size, transaction_size);
+
+  auto time_range = get_time_range(db_name);
+  auto half_of_the_topics = get_topic_ids(db_name, number_of_topics / 2);
+  std::vector<std::tuple<std::string, std::vector<sqlite3_int64>, bool>> filters = {
+    std::make_tuple("StorageQuery", std::vector<sqlite3_int64>(), false),
+    std::make_tuple("StorageQuery half of the topics", half_of_the_topics, false),
+    std::make_tuple("StorageQuery half of the topics +TOPIC_ID", half_of_the_topics, true),
+    std::make_tuple("StorageQuery single topic", get_topic_ids(db_name, 1), false)};
+  for (auto const & filter : filters) {
+    for (unsigned int seek_offset_percentage : {0u, 25u, 50u, 75u, 99u}) {
+      auto seek_timestamp =
+        time_range.first + (time_range.second - time_range.first) * seek_offset_percentage / 100;
+
+      run_benchmark_repeatedly(5,
+        db_name,
+        std::get<0>(filter),
+        std::get<1>(filter),
+        std::get<2>(filter),
+        seek_offset_percentage,
+        seek_timestamp,
+        number_of_messages_to_read,
+        write_header);
+      write_header = false;
+    }
+  }
+
+  std::remove(db_name.c_str());
+
+  return EXIT_SUCCESS;
+}
@@ -104,6 +104,23 @@ int main(int argc, char ** argv)
     msg_size_bytes,
     transaction_size, write_header);
 
+  run_benchmark_repeatedly(5,
+    "OneTableSqliteIndexedBeforeWriting",
+    std::make_shared<OneTableSqliteWriter>(
+      db_name,
+      transaction_size,
+      Indices({{"MESSAGES", "TIMESTAMP"},
+               {"MESSAGES", "TOPIC"}}),
+      // Setting to "journal_mode" to "OFF" increases writing speed, but turns off transactions.
+      Pragmas({{"journal_mode", "MEMORY"},
+               {"synchronous",  "OFF"}}),
+      true
+    ),
+    db_name,
+    msg_count,
+    msg_size_bytes,
+    transaction_size);
+
   run_benchmark_repeatedly(5,
     "SeparateTopicTableSqlite",
     std::make_shared<SeparateTopicTableSqliteWriter>(
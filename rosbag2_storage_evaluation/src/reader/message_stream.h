@@ -0,0 +1,45 @@
+/*
+ *  Copyright (c) 2018,  Bosch Software Innovations GmbH.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef ROS2_ROSBAG_EVALUATION_MESSAGE_STREAM_H
+#define ROS2_ROSBAG_EVALUATION_MESSAGE_STREAM_H
+
+#include <memory>
+
+#include "generators/message.h"
+
+namespace ros2bag
+{
+
+/**
+ * Lazily delivers the messages of a query result one after the other.
+ */
+class MessageStream
+{
+public:
+  using Ptr = std::unique_ptr<MessageStream>;
+
+  MessageStream() = default;
+
+  virtual ~MessageStream() = default;
+
+  virtual bool has_next() const = 0;
+
+  virtual MessagePtr next() = 0;
+};
+
+}
+#endif //ROS2_ROSBAG_EVALUATION_MESSAGE_STREAM_H
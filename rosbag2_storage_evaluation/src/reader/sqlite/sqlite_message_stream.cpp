@@ -0,0 +1,131 @@
+/*
+ *  Copyright (c) 2018,  Bosch Software Innovations GmbH.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include "reader/sqlite/sqlite_message_stream.h"
+
+#include <string>
+#include <vector>
+
+using namespace ros2bag;
+
+SqliteMessageStream::SqliteMessageStream(
+  sqlite::DBPtr db,
+  std::string const & query,
+  std::vector<sqlite3_int64> const & parameters)
+  : statement_(sqlite::new_select_stmt(db, query))
+{
+  for (size_t i = 0; i < parameters.size(); ++i) {
+    sqlite3_bind_int64(statement_, static_cast<int>(i + 1), parameters[i]);
+  }
+  has_row_ = sqlite3_step(statement_) == SQLITE_ROW;
+}
+
+SqliteMessageStream::~SqliteMessageStream()
+{
+  sqlite::finalize(statement_);
+}
+
+bool SqliteMessageStream::has_next() const
+{
+  return has_row_;
+}
+
+MessagePtr SqliteMessageStream::next()
+{
+  auto data = static_cast<unsigned char const *>(sqlite3_column_blob(statement_, 0));
+  auto size = static_cast<size_t>(sqlite3_column_bytes(statement_, 0));
+  auto blob = std::make_shared<std::vector<unsigned char> const>(data, data + size);
+  auto timestamp = Message::Timestamp(
+    Message::Timestamp::duration(sqlite3_column_int64(statement_, 1)));
+
+  auto message = std::make_shared<Message const>(timestamp, topic_of(statement_), blob);
+
+  has_row_ = sqlite3_step(statement_) == SQLITE_ROW;
+  return message;
+}
+
+JoinedTopicSqliteMessageStream::JoinedTopicSqliteMessageStream(sqlite::DBPtr db)
+  : SqliteMessageStream(db,
+  "SELECT DATA, TIMESTAMP, TOPICS.TOPIC "
+  "FROM MESSAGES JOIN TOPICS ON MESSAGES.TOPIC_ID = TOPICS.ID "
+  "ORDER BY MESSAGES.TIMESTAMP;")
+{}
+
+std::string JoinedTopicSqliteMessageStream::topic_of(sqlite::StatementPtr statement) const
+{
+  return reinterpret_cast<char const *>(sqlite3_column_text(statement, 2));
+}
+
+TopicIdSqliteMessageStream::TopicIdSqliteMessageStream(
+  sqlite::DBPtr db, Message::Timestamp const & from_inclusive)
+  : SqliteMessageStream(db,
+  "SELECT DATA, TIMESTAMP, TOPIC_ID FROM MESSAGES WHERE TIMESTAMP >= ? ORDER BY TIMESTAMP;",
+  {from_inclusive.time_since_epoch().count()})
+{
+  auto topics = sqlite::new_select_stmt(db, "SELECT ID, TOPIC FROM TOPICS;");
+  while (sqlite3_step(topics) == SQLITE_ROW) {
+    topic_names_[sqlite3_column_int64(topics, 0)] =
+      reinterpret_cast<char const *>(sqlite3_column_text(topics, 1));
+  }
+  sqlite::finalize(topics);
+}
+
+std::string TopicIdSqliteMessageStream::topic_of(sqlite::StatementPtr statement) const
+{
+  return topic_names_.at(sqlite3_column_int64(statement, 2));
+}
+
+StorageQuerySqliteMessageStream::StorageQuerySqliteMessageStream(
+  sqlite::DBPtr db,
+  Message::Timestamp const & from_exclusive,
+  sqlite3_int64 row_id_from_exclusive,
+  std::vector<sqlite3_int64> const & topic_ids,
+  bool scan_timestamp_index)
+  : SqliteMessageStream(db,
+  make_query(topic_ids.size(), scan_timestamp_index),
+  make_parameters(from_exclusive, row_id_from_exclusive, topic_ids))
+{}
+
+std::string StorageQuerySqliteMessageStream::make_query(
+  size_t number_of_topic_ids, bool scan_timestamp_index)
+{
+  std::string query =
+    "SELECT DATA, TIMESTAMP, TOPIC_ID FROM MESSAGES WHERE (TIMESTAMP, ROWID) > (?, ?)";
+  if (number_of_topic_ids > 0) {
+    query += scan_timestamp_index ? " AND +TOPIC_ID IN (" : " AND TOPIC_ID IN (";
+    for (size_t i = 0; i < number_of_topic_ids; ++i) {
+      query += i == 0 ? "?" : ", ?";
+    }
+    query += ")";
+  }
+  return query + " ORDER BY TIMESTAMP, ROWID;";
+}
+
+std::vector<sqlite3_int64> StorageQuerySqliteMessageStream::make_parameters(
+  Message::Timestamp const & from_exclusive,
+  sqlite3_int64 row_id_from_exclusive,
+  std::vector<sqlite3_int64> const & topic_ids)
+{
+  std::vector<sqlite3_int64> parameters = {
+    from_exclusive.time_since_epoch().count(), row_id_from_exclusive};
+  parameters.insert(parameters.end(), topic_ids.begin(), topic_ids.end());
+  return parameters;
+}
+
+std::string StorageQuerySqliteMessageStream::topic_of(sqlite::StatementPtr statement) const
+{
+  return std::to_string(sqlite3_column_int64(statement, 2));
+}
@@ -0,0 +1,117 @@
+/*
+ *  Copyright (c) 2018,  Bosch Software Innovations GmbH.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef ROS2_ROSBAG_EVALUATION_SQLITE_MESSAGE_STREAM_H
+#define ROS2_ROSBAG_EVALUATION_SQLITE_MESSAGE_STREAM_H
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "reader/message_stream.h"
+#include "writer/sqlite/sqlite.h"
+
+namespace ros2bag
+{
+
+/**
+ * Streams all messages of a database written by the SeparateTopicTableSqliteWriter in timestamp
+ * order. The first two columns of the query have to be the data and the timestamp. The given
+ * integer parameters are bound to the query in order.
+ */
+class SqliteMessageStream : public MessageStream
+{
+public:
+  SqliteMessageStream(
+    sqlite::DBPtr db,
+    std::string const & query,
+    std::vector<sqlite3_int64> const & parameters = {});
+
+  ~SqliteMessageStream() override;
+
+  bool has_next() const final;
+
+  MessagePtr next() final;
+
+protected:
+  virtual std::string topic_of(sqlite::StatementPtr statement) const = 0;
+
+private:
+  sqlite::StatementPtr statement_;
+  bool has_row_;
+};
+
+/**
+ * Resolves the topic name by joining the topics table for every message.
+ */
+class JoinedTopicSqliteMessageStream : public SqliteMessageStream
+{
+public:
+  explicit JoinedTopicSqliteMessageStream(sqlite::DBPtr db);
+
+protected:
+  std::string topic_of(sqlite::StatementPtr statement) const final;
+};
+
+/**
+ * Reads the topic id only and resolves the topic name from a table loaded once upfront.
+ * Starts with the first message not older than the given timestamp.
+ */
+class TopicIdSqliteMessageStream : public SqliteMessageStream
+{
+public:
+  explicit TopicIdSqliteMessageStream(
+    sqlite::DBPtr db, Message::Timestamp const & from_inclusive = Message::Timestamp::min());
+
+protected:
+  std::string topic_of(sqlite::StatementPtr statement) const final;
+
+private:
+  std::map<long, std::string> topic_names_;
+};
+
+/**
+ * Runs the read query of rosbag2's SqliteStorage on a database of the SeparateTopicTableSqliteWriter
+ * with the indices of rosbag2 bags. Starts after the given timestamp and row id, like reading
+ * continues after a seek or a changed filter, and reads only the given topics unless they are
+ * empty. The row id stands in for the id column, which aliases it in rosbag2 bags.
+ * SqliteStorage writes the topic filter as +TOPIC_ID if it selects a large share of the messages,
+ * which keeps SQLite on the timestamp index. scan_timestamp_index does the same.
+ */
+class StorageQuerySqliteMessageStream : public SqliteMessageStream
+{
+public:
+  StorageQuerySqliteMessageStream(
+    sqlite::DBPtr db,
+    Message::Timestamp const & from_exclusive,
+    sqlite3_int64 row_id_from_exclusive,
+    std::vector<sqlite3_int64> const & topic_ids = {},
+    bool scan_timestamp_index = false);
+
+protected:
+  std::string topic_of(sqlite::StatementPtr statement) const final;
+
+private:
+  static std::string make_query(size_t number_of_topic_ids, bool scan_timestamp_index);
+
+  static std::vector<sqlite3_int64> make_parameters(
+    Message::Timestamp const & from_exclusive,
+    sqlite3_int64 row_id_from_exclusive,
+    std::vector<sqlite3_int64> const & topic_ids);
+};
+
+}
+#endif //ROS2_ROSBAG_EVALUATION_SQLITE_MESSAGE_STREAM_H
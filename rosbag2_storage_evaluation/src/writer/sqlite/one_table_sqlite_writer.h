@@ -36,8 +36,10 @@ public:
     Indices const & indices = {{"MESSAGES", "TOPIC"},
                                {"MESSAGES", "TIMESTAMP"}},
     Pragmas const & pragmas = {{"journal_mode", "MEMORY"},
-                               {"synchronous",  "OFF"}}
-  ) : SqliteWriter(filename, messages_per_transaction, indices, pragmas)
+                               {"synchronous",  "OFF"}},
+    bool const create_indices_before_writing = false
+  ) : SqliteWriter(
+    filename, messages_per_transaction, indices, pragmas, create_indices_before_writing)
   {}
 
   ~OneTableSqliteWriter() override
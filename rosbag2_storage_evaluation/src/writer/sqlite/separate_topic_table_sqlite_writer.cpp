@@ -23,12 +23,13 @@ SeparateTopicTableSqliteWriter::SeparateTopicTableSqliteWriter(
   std::string const & filename,
   unsigned int const messages_per_transaction,
   Indices const & indices,
-  Pragmas const & pragmas
+  Pragmas const & pragmas,
+  bool const create_indices_before_writing
 ) : SqliteWriter(
   filename, messages_per_transaction, {{"MESSAGES", "TIMESTAMP"},
                                        {"MESSAGES", "TOPIC_ID"},
                                        {"TOPICS",   "TOPIC"}},
-  pragmas)
+  pragmas, create_indices_before_writing)
 {}
 
 void SeparateTopicTableSqliteWriter::close()
@@ -30,7 +30,8 @@ public:
     std::string const & filename,
     unsigned int const messages_per_transaction,
     Indices const & indices,
-    Pragmas const & pragmas);
+    Pragmas const & pragmas,
+    bool const create_indices_before_writing = false);
 
   ~SeparateTopicTableSqliteWriter() override
   {
@@ -97,6 +97,13 @@ StatementPtr ros2bag::sqlite::new_insert_stmt(DBPtr db, std::string const & tabl
   return stmt;
 }
 
+StatementPtr ros2bag::sqlite::new_select_stmt(DBPtr db, std::string const & query)
+{
+  StatementPtr stmt;
+  sqlite3_prepare_v2(db, query.c_str(), static_cast<int>(query.size()), &stmt, nullptr);
+  return stmt;
+}
+
 void ros2bag::sqlite::finalize(StatementPtr statement)
 {
   sqlite3_finalize(statement);
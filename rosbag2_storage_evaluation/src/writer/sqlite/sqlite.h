@@ -49,6 +49,8 @@ using StatementPtr = sqlite3_stmt *;
 StatementPtr new_insert_stmt(
   DBPtr db, std::string const & table, std::vector<std::string> const & fields);
 
+StatementPtr new_select_stmt(DBPtr db, std::string const & query);
+
 void finalize(StatementPtr statement);
 
 void exec(DBPtr db, std::string const & statement);
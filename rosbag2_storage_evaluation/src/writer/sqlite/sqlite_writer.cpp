@@ -27,6 +27,9 @@ void SqliteWriter::open()
     open_ = true;
     db_ = sqlite::open_db(filename_);
     initialize_tables(db_);
+    if (create_indices_before_writing_) {
+      create_index();
+    }
     set_pragmas();
     prepare_statements(db_);
   }
@@ -30,6 +30,10 @@ namespace ros2bag
 using Pragmas = std::map<std::string, std::string>;
 using Indices = std::vector<std::pair<std::string, std::string>>;
 
+/**
+ * Indices are created by create_index() once writing is done. Setting create_indices_before_writing
+ * creates them right after the tables instead, so that every insert has to maintain them.
+ */
 class SqliteWriter : public MessageWriter
 {
 public:
@@ -38,7 +42,8 @@ public:
     unsigned int const messages_per_transaction = 0,
     Indices const & indices = {},
     Pragmas const & pragmas = {{"journal_mode", "MEMORY"},
-                               {"synchronous",  "OFF"}}
+                               {"synchronous",  "OFF"}},
+    bool const create_indices_before_writing = false
   ) : filename_(filename)
     , messages_per_transaction_(messages_per_transaction)
     , number_of_message_in_current_transaction_(0)
@@ -48,6 +53,7 @@ public:
     , in_transaction_(false)
     , indices_(indices)
     , pragmas_(pragmas)
+    , create_indices_before_writing_(create_indices_before_writing)
   {}
 
   ~SqliteWriter() override
@@ -90,6 +96,7 @@ private:
   bool in_transaction_;
   Pragmas pragmas_;
   Indices indices_;
+  bool const create_indices_before_writing_;
 
   void set_pragmas();
 
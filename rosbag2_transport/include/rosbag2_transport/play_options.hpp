@@ -15,8 +15,11 @@
 #ifndef ROSBAG2_TRANSPORT__PLAY_OPTIONS_HPP_
 #define ROSBAG2_TRANSPORT__PLAY_OPTIONS_HPP_
 
+#include <chrono>
 #include <cstddef>
+#include <cstdint>
 #include <string>
+#include <vector>
 
 namespace rosbag2_transport
 {
@@ -24,8 +27,27 @@ namespace rosbag2_transport
 struct PlayOptions
 {
 public:
+  // Maximum number of messages read ahead of playback. 0 means unbounded if read_ahead_queue_bytes
+  // is set.
   size_t read_ahead_queue_size;
   std::string node_prefix = "";
+  // Topics to play. If empty, all topics of the bag are played.
+  std::vector<std::string> topics_to_filter = {};
+  // Time before publishing a message in which the player busy-waits instead of sleeping. Longer
+  // thresholds make publish times more precise, but cost CPU time.
+  std::chrono::nanoseconds spin_threshold = std::chrono::nanoseconds(0);
+  // Factor by which playback is faster than recording, e.g. 2.0 plays twice as fast. Must be > 0.
+  double rate = 1.0;
+  // Publish messages as fast as possible, without respecting their timing. Overrides rate.
+  bool max_speed = false;
+  // Maximum size in bytes of the serialized messages read ahead of playback, 0 means unbounded.
+  // The first message is read ahead regardless of its size.
+  uint64_t read_ahead_queue_bytes = 0;
+  // Number of threads publishing messages. With more than one, the topics are distributed over
+  // the threads, which publish in order on a common schedule, so a slow topic only delays the
+  // topics of its own thread. Messages waiting for their thread count as read ahead though: once
+  // the backlog of a slow topic fills the read-ahead queue, all topics are delayed to its rate.
+  size_t publishing_threads = 1;
 };
 
 }  // namespace rosbag2_transport
@@ -16,6 +16,7 @@
 #define ROSBAG2_TRANSPORT__RECORD_OPTIONS_HPP_
 
 #include <chrono>
+#include <cstddef>
 #include <string>
 #include <vector>
 
@@ -28,8 +29,17 @@ public:
   bool is_discovery_disabled;
   std::vector<std::string> topics;
   std::string rmw_serialization_format;
+  // Interval of topic discovery, used only if the middleware does not provide graph events
   std::chrono::milliseconds topic_polling_interval;
   std::string node_prefix = "";
+  // Topics matching this regex are recorded in addition to the listed topics
+  std::string regex = "";
+  // Topics matching this regex are not recorded, even if listed or matching regex
+  std::string exclude = "";
+  // Number of threads delivering recorded messages. With more than one, every topic gets its own
+  // callback group, so topics are received in parallel while each topic stays in order.
+  // 0 uses one thread per core.
+  size_t number_of_threads = 1;
 };
 
 }  // namespace rosbag2_transport
@@ -36,7 +36,8 @@ GenericSubscription::GenericSubscription(
     topic_name,
     rcl_subscription_get_default_options(),
     true),
-  default_allocator_(rcutils_get_default_allocator()),
+  message_pool_(std::make_shared<rosbag2::SerializedMessagePool>()),
+  max_message_size_(0),
   callback_(callback)
 {}
 
@@ -47,7 +48,7 @@ std::shared_ptr<void> GenericSubscription::create_message()
 
 std::shared_ptr<rmw_serialized_message_t> GenericSubscription::create_serialized_message()
 {
-  return borrow_serialized_message(0);
+  return borrow_serialized_message(max_message_size_);
 }
 
 void GenericSubscription::handle_message(
@@ -55,6 +56,12 @@ void GenericSubscription::handle_message(
 {
   (void) message_info;
   auto typed_message = std::static_pointer_cast<rmw_serialized_message_t>(message);
+  // Messages may be handled concurrently, so the maximum is only ever raised
+  auto max_message_size = max_message_size_.load();
+  while (typed_message->buffer_length > max_message_size &&
+    !max_message_size_.compare_exchange_weak(max_message_size, typed_message->buffer_length))
+  {
+  }
   callback_(typed_message);
 }
 
@@ -77,27 +84,15 @@ void GenericSubscription::return_serialized_message(
   message.reset();
 }
 
+const rosbag2::SerializedMessagePool & GenericSubscription::get_message_pool() const
+{
+  return *message_pool_;
+}
+
 std::shared_ptr<rmw_serialized_message_t>
 GenericSubscription::borrow_serialized_message(size_t capacity)
 {
-  auto message = new rmw_serialized_message_t;
-  *message = rmw_get_zero_initialized_serialized_message();
-  auto init_return = rmw_serialized_message_init(message, capacity, &default_allocator_);
-  if (init_return != RCL_RET_OK) {
-    rclcpp::exceptions::throw_from_rcl_error(init_return);
-  }
-
-  auto serialized_msg = std::shared_ptr<rmw_serialized_message_t>(message,
-      [](rmw_serialized_message_t * msg) {
-        auto fini_return = rmw_serialized_message_fini(msg);
-        delete msg;
-        if (fini_return != RCL_RET_OK) {
-          ROSBAG2_TRANSPORT_LOG_ERROR_STREAM(
-            "Failed to destroy serialized message: " << rcl_get_error_string().str);
-        }
-      });
-
-  return serialized_msg;
+  return message_pool_->acquire(capacity);
 }
 
 }  // namespace rosbag2_transport
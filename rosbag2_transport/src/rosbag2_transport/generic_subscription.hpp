@@ -15,12 +15,14 @@
 #ifndef ROSBAG2_TRANSPORT__GENERIC_SUBSCRIPTION_HPP_
 #define ROSBAG2_TRANSPORT__GENERIC_SUBSCRIPTION_HPP_
 
+#include <atomic>
 #include <memory>
 #include <string>
 
 #include "rclcpp/any_subscription_callback.hpp"
 #include "rclcpp/macros.hpp"
 #include "rclcpp/subscription.hpp"
+#include "rosbag2/types.hpp"
 
 namespace rosbag2_transport
 {
@@ -30,6 +32,10 @@ namespace rosbag2_transport
  * is not known at compile time (hence templating does not work).
  *
  * It does not support intra-process handling
+ *
+ * Message buffers are taken from a pool and return to it once the last reference to a message is
+ * dropped. They are allocated with the size of the largest message received so far, so that the
+ * middleware does not have to grow them.
  */
 class GenericSubscription : public rclcpp::SubscriptionBase
 {
@@ -67,11 +73,14 @@ public:
 
   void return_serialized_message(std::shared_ptr<rmw_serialized_message_t> & message) override;
 
+  const rosbag2::SerializedMessagePool & get_message_pool() const;
+
 private:
   RCLCPP_DISABLE_COPY(GenericSubscription)
 
   std::shared_ptr<rmw_serialized_message_t> borrow_serialized_message(size_t capacity);
-  rcutils_allocator_t default_allocator_;
+  std::shared_ptr<rosbag2::SerializedMessagePool> message_pool_;
+  std::atomic<size_t> max_message_size_;
   std::function<void(std::shared_ptr<rmw_serialized_message_t>)> callback_;
 };
 
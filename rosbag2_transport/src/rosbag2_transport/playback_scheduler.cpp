@@ -0,0 +1,150 @@
+// Copyright 2018, Bosch Software Innovations GmbH.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "playback_scheduler.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace rosbag2_transport
+{
+
+PlaybackScheduler::PlaybackScheduler(std::chrono::nanoseconds spin_threshold, double rate)
+: spin_threshold_(std::max(spin_threshold, std::chrono::nanoseconds(0))),
+  rate_(rate),
+  start_time_(Clock::now()),
+  lateness_histogram_(number_of_lateness_buckets_, 0),
+  message_count_(0),
+  total_lateness_(0),
+  max_lateness_(0)
+{
+  if (!(rate_ > 0)) {
+    throw std::runtime_error("Playback rate must be positive, but is " + std::to_string(rate_));
+  }
+}
+
+void PlaybackScheduler::start()
+{
+  start_time_ = Clock::now();
+}
+
+void PlaybackScheduler::wait_until(std::chrono::nanoseconds time_since_start) const
+{
+  const auto scheduled_time = get_scheduled_time(time_since_start);
+  if (spin_threshold_ == std::chrono::nanoseconds(0)) {
+    std::this_thread::sleep_until(scheduled_time);
+    return;
+  }
+
+  const auto sleep_until_time = scheduled_time - spin_threshold_;
+  if (Clock::now() < sleep_until_time) {
+    std::this_thread::sleep_until(sleep_until_time);
+  }
+  while (Clock::now() < scheduled_time) {
+    // busy-wait for the remaining time
+  }
+}
+
+std::chrono::nanoseconds PlaybackScheduler::get_elapsed_time() const
+{
+  return Clock::now() - start_time_;
+}
+
+void PlaybackScheduler::record_publish(std::chrono::nanoseconds time_since_start)
+{
+  record_lateness(Clock::now() - get_scheduled_time(time_since_start));
+}
+
+void PlaybackScheduler::record_lateness(std::chrono::nanoseconds lateness)
+{
+  lateness = std::max(lateness, std::chrono::nanoseconds(0));
+  auto lateness_us = std::chrono::duration_cast<std::chrono::microseconds>(lateness).count();
+  size_t bucket = 0;
+  while (lateness_us > 0 && bucket < number_of_lateness_buckets_ - 1) {
+    lateness_us >>= 1;
+    ++bucket;
+  }
+
+  ++lateness_histogram_[bucket];
+  ++message_count_;
+  total_lateness_ += lateness;
+  max_lateness_ = std::max(max_lateness_, lateness);
+}
+
+PlaybackScheduler::Clock::time_point
+PlaybackScheduler::get_scheduled_time(std::chrono::nanoseconds time_since_start) const
+{
+  if (rate_ == 1.0) {
+    return start_time_ + time_since_start;
+  }
+  return start_time_ + std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::duration<double, std::nano>(time_since_start) / rate_);
+}
+
+void PlaybackScheduler::merge_lateness(const PlaybackScheduler & other)
+{
+  for (size_t bucket = 0; bucket < lateness_histogram_.size(); ++bucket) {
+    lateness_histogram_[bucket] += other.lateness_histogram_[bucket];
+  }
+  message_count_ += other.message_count_;
+  total_lateness_ += other.total_lateness_;
+  max_lateness_ = std::max(max_lateness_, other.max_lateness_);
+}
+
+const std::vector<size_t> & PlaybackScheduler::get_lateness_histogram() const
+{
+  return lateness_histogram_;
+}
+
+size_t PlaybackScheduler::get_message_count() const
+{
+  return message_count_;
+}
+
+std::chrono::nanoseconds PlaybackScheduler::get_max_lateness() const
+{
+  return max_lateness_;
+}
+
+std::string PlaybackScheduler::format_lateness_histogram() const
+{
+  using std::chrono::duration_cast;
+  using std::chrono::microseconds;
+
+  std::stringstream stream;
+  stream << "Publish lateness of " << message_count_ << " messages: mean " <<
+    (message_count_ == 0 ? 0 : duration_cast<microseconds>(total_lateness_).count() /
+    static_cast<int64_t>(message_count_)) << " us, max " <<
+    duration_cast<microseconds>(max_lateness_).count() << " us";
+  for (size_t bucket = 0; bucket < lateness_histogram_.size(); ++bucket) {
+    if (lateness_histogram_[bucket] == 0) {
+      continue;
+    }
+    stream << "\n  ";
+    if (bucket == lateness_histogram_.size() - 1) {
+      stream << ">= " << (1ll << (bucket - 1)) << " us: ";
+    } else {
+      stream << "< " << (1ll << bucket) << " us: ";
+    }
+    stream << lateness_histogram_[bucket];
+  }
+  return stream.str();
+}
+
+}  // namespace rosbag2_transport
@@ -0,0 +1,93 @@
+// Copyright 2018, Bosch Software Innovations GmbH.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROSBAG2_TRANSPORT__PLAYBACK_SCHEDULER_HPP_
+#define ROSBAG2_TRANSPORT__PLAYBACK_SCHEDULER_HPP_
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace rosbag2_transport
+{
+
+/**
+ * Schedules the publishing of played messages on the monotonic steady_clock, so playback is not
+ * affected by adjustments of the system time. Times since the start of playback are divided by the
+ * playback rate.
+ *
+ * Waiting sleeps until spin_threshold before the scheduled time and busy-waits for the rest,
+ * which avoids the wake-up jitter of the operating system at the cost of CPU time. The lateness
+ * of published messages is collected in a histogram with power of two microsecond buckets.
+ */
+class PlaybackScheduler
+{
+public:
+  using Clock = std::chrono::steady_clock;
+
+  /**
+   * \throws std::runtime_error if the rate is not positive.
+   */
+  explicit PlaybackScheduler(
+    std::chrono::nanoseconds spin_threshold = std::chrono::nanoseconds(0), double rate = 1.0);
+
+  // Sets the time at which playback started to now.
+  void start();
+
+  // Blocks until the given time since the start of playback, scaled by the rate.
+  void wait_until(std::chrono::nanoseconds time_since_start) const;
+
+  // Returns the point in time at which a message with the given time since start is due.
+  Clock::time_point get_scheduled_time(std::chrono::nanoseconds time_since_start) const;
+
+  // Returns the time elapsed since the start of playback.
+  std::chrono::nanoseconds get_elapsed_time() const;
+
+  // Records the lateness of a message scheduled for the given time, which was published just now.
+  void record_publish(std::chrono::nanoseconds time_since_start);
+
+  void record_lateness(std::chrono::nanoseconds lateness);
+
+  // Adds the lateness recorded by another scheduler, e.g. a copy used by another thread.
+  void merge_lateness(const PlaybackScheduler & other);
+
+  /**
+   * Returns the number of messages per lateness bucket. Bucket 0 counts messages late by less
+   * than 1 us, bucket i > 0 those late by [2^(i-1), 2^i) us. The last bucket is unbounded.
+   */
+  const std::vector<size_t> & get_lateness_histogram() const;
+
+  size_t get_message_count() const;
+
+  std::chrono::nanoseconds get_max_lateness() const;
+
+  // Formats mean and maximum lateness as well as all non-empty buckets.
+  std::string format_lateness_histogram() const;
+
+private:
+  static constexpr size_t number_of_lateness_buckets_ = 22;
+
+  std::chrono::nanoseconds spin_threshold_;
+  double rate_;
+  Clock::time_point start_time_;
+  std::vector<size_t> lateness_histogram_;
+  size_t message_count_;
+  std::chrono::nanoseconds total_lateness_;
+  std::chrono::nanoseconds max_lateness_;
+};
+
+}  // namespace rosbag2_transport
+
+#endif  // ROSBAG2_TRANSPORT__PLAYBACK_SCHEDULER_HPP_
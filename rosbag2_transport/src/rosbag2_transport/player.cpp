@@ -14,10 +14,13 @@
 
 #include "player.hpp"
 
+#include <algorithm>
 #include <chrono>
 #include <memory>
+#include <mutex>
 #include <queue>
 #include <string>
+#include <thread>
 #include <vector>
 #include <utility>
 
@@ -28,6 +31,7 @@
 #include "rosbag2/sequential_reader.hpp"
 #include "rosbag2/typesupport_helpers.hpp"
 #include "rosbag2_transport/logging.hpp"
+#include "playback_scheduler.hpp"
 #include "rosbag2_node.hpp"
 #include "replayable_message.hpp"
 
@@ -36,10 +40,23 @@ namespace rosbag2_transport
 
 const std::chrono::milliseconds
 Player::queue_read_wait_period_ = std::chrono::milliseconds(100);
+const std::chrono::milliseconds
+Player::publishing_worker_lead_time_ = std::chrono::milliseconds(10);
 
 Player::Player(
   std::shared_ptr<rosbag2::SequentialReader> reader, std::shared_ptr<Rosbag2Node> rosbag2_transport)
-: reader_(std::move(reader)), rosbag2_transport_(rosbag2_transport)
+: reader_(std::move(reader)),
+  queue_lower_boundary_(0),
+  queue_upper_boundary_(0),
+  queue_lower_boundary_bytes_(0),
+  queue_upper_boundary_bytes_(0),
+  queued_messages_(0),
+  queued_bytes_(0),
+  is_loading_finished_(false),
+  publishing_state_{PlaybackScheduler(), 0, 0},
+  max_speed_(false),
+  number_of_publishing_threads_(1),
+  rosbag2_transport_(rosbag2_transport)
 {}
 
 bool Player::is_storage_completely_loaded() const
@@ -54,27 +71,49 @@ bool Player::is_storage_completely_loaded() const
 
 void Player::play(const PlayOptions & options)
 {
-  prepare_publishers();
+  publishing_state_ = {PlaybackScheduler(options.spin_threshold, options.rate), 0, 0};
+  max_speed_ = options.max_speed;
+  number_of_publishing_threads_ = options.publishing_threads;
+
+  if (!options.topics_to_filter.empty()) {
+    rosbag2::StorageFilter storage_filter;
+    storage_filter.topics = options.topics_to_filter;
+    reader_->set_filter(storage_filter);
+  }
 
+  prepare_publishers(options);
+
+  queue_upper_boundary_ = options.read_ahead_queue_bytes == 0 ?
+    std::max<size_t>(options.read_ahead_queue_size, 1) :
+    options.read_ahead_queue_size;
+  queue_lower_boundary_ = std::max<size_t>(
+    static_cast<size_t>(queue_upper_boundary_ * read_ahead_lower_bound_percentage_), 1);
+  queue_upper_boundary_bytes_ = options.read_ahead_queue_bytes;
+  queue_lower_boundary_bytes_ = std::max<uint64_t>(
+    static_cast<uint64_t>(queue_upper_boundary_bytes_ * read_ahead_lower_bound_percentage_), 1);
+  queued_messages_ = 0;
+  queued_bytes_ = 0;
+  is_loading_finished_ = false;
   storage_loading_future_ = std::async(std::launch::async,
-      [this, options]() {load_storage_content(options);});
+      [this]() {load_storage_content();});
 
-  wait_for_filled_queue(options);
+  wait_for_filled_queue();
 
   play_messages_from_queue();
 }
 
-void Player::wait_for_filled_queue(const PlayOptions & options) const
+void Player::wait_for_filled_queue()
 {
+  std::unique_lock<std::mutex> lock(queue_mutex_);
   while (
-    message_queue_.size_approx() < options.read_ahead_queue_size &&
-    !is_storage_completely_loaded() && rclcpp::ok())
+    !is_queue_full() && !is_loading_finished_ && !is_storage_completely_loaded() && rclcpp::ok())
   {
-    std::this_thread::sleep_for(queue_read_wait_period_);
+    // The timeout guards against shutdown, which is not notified
+    queue_filled_condition_.wait_for(lock, queue_read_wait_period_);
   }
 }
 
-void Player::load_storage_content(const PlayOptions & options)
+void Player::load_storage_content()
 {
   TimePoint time_first_message;
 
@@ -83,64 +122,275 @@ void Player::load_storage_content(const PlayOptions & options)
     message.message = reader_->read_next();
     message.time_since_start = std::chrono::nanoseconds(0);
     time_first_message = TimePoint(std::chrono::nanoseconds(message.message->time_stamp));
-    message_queue_.enqueue(message);
+    enqueue(message);
   }
 
-  auto queue_lower_boundary =
-    static_cast<size_t>(options.read_ahead_queue_size * read_ahead_lower_bound_percentage_);
-  auto queue_upper_boundary = options.read_ahead_queue_size;
-
   while (reader_->has_next() && rclcpp::ok()) {
-    if (message_queue_.size_approx() < queue_lower_boundary) {
-      enqueue_up_to_boundary(time_first_message, queue_upper_boundary);
-    } else {
-      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    enqueue_up_to_boundary(time_first_message);
+    notify_queue_filled();
+    wait_for_queue_space();
+  }
+
+  // An empty message marks the end of the queue, so the publishing thread does not need to wait
+  message_queue_.enqueue(ReplayableMessage{nullptr, std::chrono::nanoseconds(0)});
+  is_loading_finished_ = true;
+  notify_queue_filled();
+}
+
+void Player::notify_queue_filled()
+{
+  {
+    // Taking the lock ensures that the waiting thread does not miss the notification between its
+    // check and wait
+    std::lock_guard<std::mutex> lock(queue_mutex_);
+  }
+  queue_filled_condition_.notify_all();
+}
+
+void Player::wait_for_queue_space()
+{
+  std::unique_lock<std::mutex> lock(queue_mutex_);
+  while (!is_queue_below_lower_boundary() && rclcpp::ok()) {
+    queue_space_condition_.wait_for(lock, queue_read_wait_period_);
+  }
+}
+
+void Player::notify_queue_space()
+{
+  if (is_queue_below_lower_boundary()) {
+    {
+      std::lock_guard<std::mutex> lock(queue_mutex_);
     }
+    queue_space_condition_.notify_one();
   }
 }
 
-void Player::enqueue_up_to_boundary(const TimePoint & time_first_message, uint64_t boundary)
+bool Player::is_queue_full() const
+{
+  return (queue_upper_boundary_ != 0 && queued_messages_ >= queue_upper_boundary_) ||
+         (queue_upper_boundary_bytes_ != 0 && queued_bytes_ >= queue_upper_boundary_bytes_);
+}
+
+bool Player::is_queue_below_lower_boundary() const
+{
+  return (queue_upper_boundary_ == 0 || queued_messages_ < queue_lower_boundary_) &&
+         (queue_upper_boundary_bytes_ == 0 || queued_bytes_ < queue_lower_boundary_bytes_);
+}
+
+uint64_t Player::get_message_size(const ReplayableMessage & message)
+{
+  return message.message && message.message->serialized_data ?
+         message.message->serialized_data->buffer_capacity :
+         0;
+}
+
+void Player::enqueue(const ReplayableMessage & message)
+{
+  ++queued_messages_;
+  queued_bytes_ += get_message_size(message);
+  message_queue_.enqueue(message);
+}
+
+void Player::release_queued_message(const ReplayableMessage & message)
+{
+  --queued_messages_;
+  queued_bytes_ -= get_message_size(message);
+  notify_queue_space();
+}
+
+void Player::enqueue_up_to_boundary(const TimePoint & time_first_message)
 {
   ReplayableMessage message;
-  for (size_t i = message_queue_.size_approx(); i < boundary; i++) {
-    if (!reader_->has_next()) {
-      break;
-    }
+  while (!is_queue_full() && reader_->has_next()) {
     message.message = reader_->read_next();
     message.time_since_start =
       TimePoint(std::chrono::nanoseconds(message.message->time_stamp)) - time_first_message;
 
-    message_queue_.enqueue(message);
+    enqueue(message);
   }
 }
 
 void Player::play_messages_from_queue()
 {
-  start_time_ = std::chrono::system_clock::now();
-  do {
-    play_messages_until_queue_empty();
-    if (!is_storage_completely_loaded() && rclcpp::ok()) {
-      ROSBAG2_TRANSPORT_LOG_WARN("Message queue starved. Messages will be delayed. Consider "
-        "increasing the --read-ahead-queue-size option.");
+  publishing_state_.scheduler.start();
+  if (number_of_publishing_threads_ > 1) {
+    start_publishing_workers(number_of_publishing_threads_);
+  }
+
+  ReplayableMessage message;
+  bool is_starvation_reported = false;
+  try {
+    while (rclcpp::ok()) {
+      bool was_queue_empty = false;
+      if (!message_queue_.try_dequeue(message)) {
+        was_queue_empty = true;
+        if (!message_queue_.wait_dequeue_timed(message, queue_read_wait_period_)) {
+          // The loading thread only stops without end marker if it failed or rclcpp shut down
+          if (is_storage_completely_loaded()) {
+            break;
+          }
+          continue;
+        }
+      }
+      if (!message.message) {
+        break;
+      }
+      // An empty queue only delays playback if the message became due while waiting for it
+      if (was_queue_empty && !max_speed_ && !is_starvation_reported &&
+        publishing_state_.scheduler.get_scheduled_time(message.time_since_start) <
+        PlaybackScheduler::Clock::now())
+      {
+        ROSBAG2_TRANSPORT_LOG_WARN("Message queue starved. Messages will be delayed. Consider "
+          "increasing the --read-ahead-queue-size or --read-ahead-queue-bytes option.");
+        is_starvation_reported = true;
+      }
+      if (publishing_workers_.empty()) {
+        release_queued_message(message);
+        play_message(message, publishing_state_);
+      } else {
+        dispatch_message(message);
+      }
     }
-  } while (!is_storage_completely_loaded() && rclcpp::ok());
+  } catch (...) {
+    // Joinable worker threads would terminate the process on destruction of the player
+    stop_publishing_workers();
+    throw;
+  }
+  stop_publishing_workers();
+
+  if (max_speed_) {
+    log_throughput();
+  } else {
+    ROSBAG2_TRANSPORT_LOG_INFO_STREAM(publishing_state_.scheduler.format_lateness_histogram());
+  }
+}
+
+void Player::start_publishing_workers(size_t number_of_workers)
+{
+  number_of_workers = std::min(number_of_workers, publishers_.size());
+  for (size_t i = 0; i < number_of_workers; ++i) {
+    // Copies of the started scheduler share its timeline
+    publishing_workers_.push_back(
+      std::make_unique<PublishingWorker>(publishing_state_.scheduler));
+  }
+  size_t worker_index = 0;
+  for (const auto & publisher : publishers_) {
+    topic_publishing_workers_[publisher.first] = publishing_workers_[worker_index].get();
+    worker_index = (worker_index + 1) % publishing_workers_.size();
+  }
+  for (auto & worker : publishing_workers_) {
+    auto worker_ptr = worker.get();
+    worker->thread = std::thread([this, worker_ptr]() {run_publishing_worker(*worker_ptr);});
+  }
+}
+
+void Player::stop_publishing_workers()
+{
+  for (auto & worker : publishing_workers_) {
+    worker->queue.enqueue(ReplayableMessage{nullptr, std::chrono::nanoseconds(0)});
+  }
+  for (auto & worker : publishing_workers_) {
+    worker->thread.join();
+    publishing_state_.scheduler.merge_lateness(worker->state.scheduler);
+    publishing_state_.published_messages += worker->state.published_messages;
+    publishing_state_.published_bytes += worker->state.published_bytes;
+  }
+  publishing_workers_.clear();
+  topic_publishing_workers_.clear();
+}
+
+void Player::dispatch_message(const ReplayableMessage & message)
+{
+  auto & worker = *topic_publishing_workers_.at(message.message->topic_name);
+
+  // Workers get their messages shortly before they are due, so that they neither run dry nor
+  // queue up the bag
+  if (!max_speed_) {
+    std::this_thread::sleep_until(
+      publishing_state_.scheduler.get_scheduled_time(message.time_since_start) -
+      publishing_worker_lead_time_);
+  }
+  // Never blocks, the read-ahead boundaries limit the messages queued for the workers
+  worker.queue.enqueue(message);
 }
 
-void Player::play_messages_until_queue_empty()
+void Player::run_publishing_worker(PublishingWorker & worker)
 {
   ReplayableMessage message;
-  while (message_queue_.try_dequeue(message) && rclcpp::ok()) {
-    std::this_thread::sleep_until(start_time_ + message.time_since_start);
-    if (rclcpp::ok()) {
-      publishers_[message.message->topic_name]->publish(message.message->serialized_data);
+  while (true) {
+    if (!worker.queue.wait_dequeue_timed(message, queue_read_wait_period_)) {
+      if (!rclcpp::ok()) {
+        break;
+      }
+      continue;
+    }
+    if (!message.message) {
+      break;
+    }
+    release_queued_message(message);
+
+    try {
+      play_message(message, worker.state);
+    } catch (const std::runtime_error & e) {
+      ROSBAG2_TRANSPORT_LOG_ERROR_STREAM(
+        "Failed to publish message on topic '" << message.message->topic_name << "': " <<
+          e.what());
+    }
+  }
+}
+
+void Player::log_throughput() const
+{
+  const auto seconds =
+    std::chrono::duration<double>(publishing_state_.scheduler.get_elapsed_time()).count();
+  const auto messages = publishing_state_.published_messages;
+  const auto megabytes = static_cast<double>(publishing_state_.published_bytes) / 1e6;
+  ROSBAG2_TRANSPORT_LOG_INFO_STREAM(
+    "Played " << messages << " messages (" << megabytes << " MB) in " << seconds <<
+      " s: " << (seconds > 0 ? messages / seconds : 0) << " messages/s, " <<
+      (seconds > 0 ? megabytes / seconds : 0) << " MB/s");
+}
+
+void Player::play_message(const ReplayableMessage & message, PublishingState & state)
+{
+  if (!max_speed_) {
+    state.scheduler.wait_until(message.time_since_start);
+  }
+  if (rclcpp::ok()) {
+    publish(message);
+    if (max_speed_) {
+      ++state.published_messages;
+      state.published_bytes += message.message->serialized_data->buffer_length;
+    } else {
+      state.scheduler.record_publish(message.time_since_start);
     }
   }
 }
 
-void Player::prepare_publishers()
+void Player::publish(const ReplayableMessage & message)
+{
+  // at() does not modify the map, which may be read by several publishing threads
+  publishers_.at(message.message->topic_name)->publish(message.message->serialized_data);
+}
+
+void Player::prepare_publishers(const PlayOptions & options)
 {
+  const auto & topics_to_filter = options.topics_to_filter;
   auto topics = reader_->get_all_topics_and_types();
+
+  std::vector<std::string> types;
   for (const auto & topic : topics) {
+    types.push_back(topic.type);
+  }
+  rosbag2::preload_typesupports(types, "rosidl_typesupport_cpp");
+
+  for (const auto & topic : topics) {
+    if (!topics_to_filter.empty() &&
+      std::find(topics_to_filter.begin(), topics_to_filter.end(), topic.name) ==
+      topics_to_filter.end())
+    {
+      continue;
+    }
     publishers_.insert(std::make_pair(
         topic.name, rosbag2_transport_->create_generic_publisher(topic.name, topic.type)));
   }
@@ -15,14 +15,20 @@
 #ifndef ROSBAG2_TRANSPORT__PLAYER_HPP_
 #define ROSBAG2_TRANSPORT__PLAYER_HPP_
 
+#include <atomic>
 #include <chrono>
+#include <condition_variable>
 #include <future>
 #include <memory>
+#include <mutex>
 #include <queue>
 #include <string>
+#include <thread>
 #include <unordered_map>
+#include <vector>
 
 #include "moodycamel/readerwriterqueue.h"
+#include "playback_scheduler.hpp"
 #include "replayable_message.hpp"
 #include "rosbag2/types.hpp"
 #include "rosbag2_transport/play_options.hpp"
@@ -47,23 +53,82 @@ public:
     std::shared_ptr<rosbag2::SequentialReader> reader,
     std::shared_ptr<Rosbag2Node> rosbag2_transport);
 
+  virtual ~Player() = default;
+
   void play(const PlayOptions & options);
 
+protected:
+  // Publishes the message on its topic, possibly on several threads at once
+  virtual void publish(const ReplayableMessage & message);
+
 private:
-  void load_storage_content(const PlayOptions & options);
+  void load_storage_content();
   bool is_storage_completely_loaded() const;
-  void enqueue_up_to_boundary(const TimePoint & time_first_message, uint64_t boundary);
-  void wait_for_filled_queue(const PlayOptions & options) const;
+  void enqueue(const ReplayableMessage & message);
+  void release_queued_message(const ReplayableMessage & message);
+  void enqueue_up_to_boundary(const TimePoint & time_first_message);
+  bool is_queue_full() const;
+  bool is_queue_below_lower_boundary() const;
+  static uint64_t get_message_size(const ReplayableMessage & message);
+  void wait_for_filled_queue();
+  void notify_queue_filled();
+  void wait_for_queue_space();
+  void notify_queue_space();
   void play_messages_from_queue();
-  void play_messages_until_queue_empty();
-  void prepare_publishers();
+  void prepare_publishers(const PlayOptions & options);
+  void log_throughput() const;
+
+  // Schedule and statistics of a thread publishing messages
+  struct PublishingState
+  {
+    PlaybackScheduler scheduler;
+    size_t published_messages;
+    uint64_t published_bytes;
+  };
+
+  // Thread publishing the messages of some topics in order, fed by the playing thread
+  struct PublishingWorker
+  {
+    explicit PublishingWorker(const PlaybackScheduler & scheduler)
+    : state{scheduler, 0, 0} {}
+
+    moodycamel::BlockingReaderWriterQueue<ReplayableMessage> queue;
+    PublishingState state;
+    std::thread thread;
+  };
+
+  void play_message(const ReplayableMessage & message, PublishingState & state);
+  void start_publishing_workers(size_t number_of_workers);
+  void stop_publishing_workers();
+  void dispatch_message(const ReplayableMessage & message);
+  void run_publishing_worker(PublishingWorker & worker);
 
   static constexpr double read_ahead_lower_bound_percentage_ = 0.9;
   static const std::chrono::milliseconds queue_read_wait_period_;
+  static const std::chrono::milliseconds publishing_worker_lead_time_;
 
   std::shared_ptr<rosbag2::SequentialReader> reader_;
-  moodycamel::ReaderWriterQueue<ReplayableMessage> message_queue_;
-  std::chrono::time_point<std::chrono::system_clock> start_time_;
+  moodycamel::BlockingReaderWriterQueue<ReplayableMessage> message_queue_;
+  // The loading thread refills the queue up to the upper boundaries whenever it falls below both
+  // lower boundaries. Boundaries of 0 are unbounded. Messages dispatched to publishing workers
+  // count as queued until their worker takes them, so a slow topic does not stall the dispatching
+  // of others but the queued messages stay within the boundaries. queue_mutex_ only guards the
+  // waits on the conditions, not the queue itself.
+  size_t queue_lower_boundary_;
+  size_t queue_upper_boundary_;
+  uint64_t queue_lower_boundary_bytes_;
+  uint64_t queue_upper_boundary_bytes_;
+  std::atomic<size_t> queued_messages_;
+  std::atomic<uint64_t> queued_bytes_;
+  std::atomic<bool> is_loading_finished_;
+  std::mutex queue_mutex_;
+  std::condition_variable queue_space_condition_;
+  std::condition_variable queue_filled_condition_;
+  PublishingState publishing_state_;
+  bool max_speed_;
+  size_t number_of_publishing_threads_;
+  std::vector<std::unique_ptr<PublishingWorker>> publishing_workers_;
+  std::unordered_map<std::string, PublishingWorker *> topic_publishing_workers_;
   mutable std::future<void> storage_loading_future_;
   std::shared_ptr<Rosbag2Node> rosbag2_transport_;
   std::unordered_map<std::string, std::shared_ptr<GenericPublisher>> publishers_;
@@ -15,6 +15,7 @@
 #include "recorder.hpp"
 
 #include <algorithm>
+#include <chrono>
 #include <future>
 #include <memory>
 #include <stdexcept>
@@ -23,15 +24,20 @@
 #include <utility>
 #include <vector>
 
+#include "rclcpp/executors/multi_threaded_executor.hpp"
+#include "rosbag2/typesupport_helpers.hpp"
 #include "rosbag2/writer.hpp"
 #include "rosbag2_transport/logging.hpp"
 #include "generic_subscription.hpp"
 #include "rosbag2_node.hpp"
+#include "topic_filter.hpp"
 
 namespace rosbag2_transport
 {
+const std::chrono::seconds Recorder::graph_event_wait_period_ = std::chrono::seconds(1);
+
 Recorder::Recorder(std::shared_ptr<rosbag2::Writer> writer, std::shared_ptr<Rosbag2Node> node)
-: writer_(std::move(writer)), node_(std::move(node)) {}
+: writer_(std::move(writer)), node_(std::move(node)), number_of_threads_(1) {}
 
 void Recorder::record(const RecordOptions & record_options)
 {
@@ -39,14 +45,19 @@ void Recorder::record(const RecordOptions & record_options)
     throw std::runtime_error("No serialization format specified!");
   }
   serialization_format_ = record_options.rmw_serialization_format;
+  number_of_threads_ = record_options.number_of_threads;
+  // Requested names are expanded and regexes compiled only once, not on every discovery
+  topic_filter_ = std::make_unique<TopicFilter>(
+    node_->expand_topic_names(record_options.topics),
+    record_options.regex,
+    record_options.exclude);
   ROSBAG2_TRANSPORT_LOG_INFO("Listening for topics...");
-  subscribe_topics(get_requested_or_available_topics(record_options.topics));
+  subscribe_topics(get_requested_or_available_topics());
 
   std::future<void> discovery_future;
   if (!record_options.is_discovery_disabled) {
     auto discovery = std::bind(
-      &Recorder::topics_discovery, this,
-      record_options.topic_polling_interval, record_options.topics);
+      &Recorder::topics_discovery, this, record_options.topic_polling_interval);
     discovery_future = std::async(std::launch::async, discovery);
   }
 
@@ -56,32 +67,62 @@ void Recorder::record(const RecordOptions & record_options)
     discovery_future.wait();
   }
 
+  for (const auto & subscription : subscriptions_) {
+    const auto & message_pool = subscription->get_message_pool();
+    ROSBAG2_TRANSPORT_LOG_DEBUG_STREAM(
+      "Message buffers of topic '" << subscription->get_topic_name() << "': " <<
+        message_pool.get_hit_count() << " reused, " << message_pool.get_miss_count() <<
+        " allocated");
+  }
   subscriptions_.clear();
 }
 
-void Recorder::topics_discovery(
-  std::chrono::milliseconds topic_polling_interval,
-  const std::vector<std::string> & requested_topics)
+void Recorder::topics_discovery(std::chrono::milliseconds topic_polling_interval)
 {
+  auto graph_event = get_graph_event();
   while (rclcpp::ok()) {
-    auto topics_to_subscribe = get_requested_or_available_topics(requested_topics);
+    auto topics_to_subscribe = get_requested_or_available_topics();
     auto missing_topics = get_missing_topics(topics_to_subscribe);
     subscribe_topics(missing_topics);
 
-    if (!requested_topics.empty() && subscribed_topics_.size() == requested_topics.size()) {
+    if (topic_filter_->selects_fixed_topics() &&
+      subscribed_topics_.size() == topic_filter_->get_topic_names().size())
+    {
       ROSBAG2_TRANSPORT_LOG_INFO("All requested topics are subscribed. Stopping discovery...");
       return;
     }
-    std::this_thread::sleep_for(topic_polling_interval);
+    if (graph_event) {
+      wait_for_graph_change(graph_event);
+    } else {
+      std::this_thread::sleep_for(topic_polling_interval);
+    }
+  }
+}
+
+rclcpp::Event::SharedPtr Recorder::get_graph_event() const
+{
+  try {
+    return node_->get_node_graph_interface()->get_graph_event();
+  } catch (const std::runtime_error & ex) {
+    ROSBAG2_TRANSPORT_LOG_WARN_STREAM(
+      "Graph events are not available, polling for new topics instead. Error: " << ex.what());
+    return nullptr;
+  }
+}
+
+void Recorder::wait_for_graph_change(const rclcpp::Event::SharedPtr & graph_event) const
+{
+  // The graph event is also notified on shutdown, the timeout only guards against missed wake-ups
+  auto node_graph = node_->get_node_graph_interface();
+  while (rclcpp::ok() && !graph_event->check_and_clear()) {
+    node_graph->wait_for_graph_change(graph_event, graph_event_wait_period_);
   }
 }
 
 std::unordered_map<std::string, std::string>
-Recorder::get_requested_or_available_topics(const std::vector<std::string> & requested_topics)
+Recorder::get_requested_or_available_topics()
 {
-  return requested_topics.empty() ?
-         node_->get_all_topics_with_types() :
-         node_->get_topics_with_types(requested_topics);
+  return node_->get_selected_topics_with_types(*topic_filter_);
 }
 
 std::unordered_map<std::string, std::string>
@@ -99,6 +140,12 @@ Recorder::get_missing_topics(const std::unordered_map<std::string, std::string>
 void Recorder::subscribe_topics(
   const std::unordered_map<std::string, std::string> & topics_and_types)
 {
+  std::vector<std::string> types;
+  for (const auto & topic_with_type : topics_and_types) {
+    types.push_back(topic_with_type.second);
+  }
+  rosbag2::preload_typesupports(types, "rosidl_typesupport_cpp");
+
   for (const auto & topic_with_type : topics_and_types) {
     subscribe_topic({topic_with_type.first, topic_with_type.second, serialization_format_});
   }
@@ -106,10 +153,11 @@ void Recorder::subscribe_topics(
 
 void Recorder::subscribe_topic(const rosbag2::TopicMetadata & topic)
 {
-  auto subscription = create_subscription(topic.name, topic.type);
+  // The topic is created first, so that its id is known to the subscription callback
+  auto topic_id = writer_->create_topic(topic);
+  auto subscription = create_subscription(topic.name, topic.type, topic_id);
 
   if (subscription) {
-    writer_->create_topic(topic);
     subscribed_topics_.insert(topic.name);
     subscriptions_.push_back(subscription);
     ROSBAG2_TRANSPORT_LOG_INFO_STREAM("Subscribed to topic '" << topic.name << "'");
@@ -121,31 +169,46 @@ void Recorder::subscribe_topic(const rosbag2::TopicMetadata & topic)
 
 std::shared_ptr<GenericSubscription>
 Recorder::create_subscription(
-  const std::string & topic_name, const std::string & topic_type)
+  const std::string & topic_name, const std::string & topic_type, rosbag2::TopicId topic_id)
 {
+  // With several threads, each topic is mutually exclusive only with itself, so that a slow topic
+  // does not hold back the others while its own messages are still written in order.
+  rclcpp::callback_group::CallbackGroup::SharedPtr callback_group = nullptr;
+  if (number_of_threads_ != 1) {
+    callback_group = node_->create_callback_group(
+      rclcpp::callback_group::CallbackGroupType::MutuallyExclusive);
+  }
+
   auto subscription = node_->create_generic_subscription(
     topic_name,
     topic_type,
-    [this, topic_name](std::shared_ptr<rmw_serialized_message_t> message) {
-      auto bag_message = std::make_shared<rosbag2::SerializedBagMessage>();
-      bag_message->serialized_data = message;
-      bag_message->topic_name = topic_name;
+    [this, topic_id](std::shared_ptr<rmw_serialized_message_t> message) {
       rcutils_time_point_value_t time_stamp;
       int error = rcutils_system_time_now(&time_stamp);
       if (error != RCUTILS_RET_OK) {
         ROSBAG2_TRANSPORT_LOG_ERROR_STREAM(
           "Error getting current time. Error:" << rcutils_get_error_string().str);
       }
-      bag_message->time_stamp = time_stamp;
 
-      writer_->write(bag_message);
-    });
+      writer_->write(topic_id, message, time_stamp);
+    },
+    callback_group);
   return subscription;
 }
 
 void Recorder::record_messages() const
 {
-  spin(node_);
+  if (number_of_threads_ == 1) {
+    spin(node_);
+    return;
+  }
+
+  rclcpp::executors::MultiThreadedExecutor executor(
+    rclcpp::executor::create_default_executor_arguments(), number_of_threads_);
+  ROSBAG2_TRANSPORT_LOG_DEBUG_STREAM(
+    "Recording with " << executor.get_number_of_threads() << " threads");
+  executor.add_node(node_);
+  executor.spin();
 }
 
 }  // namespace rosbag2_transport
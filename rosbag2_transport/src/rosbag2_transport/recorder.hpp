@@ -15,6 +15,7 @@
 #ifndef ROSBAG2_TRANSPORT__RECORDER_HPP_
 #define ROSBAG2_TRANSPORT__RECORDER_HPP_
 
+#include <chrono>
 #include <future>
 #include <memory>
 #include <string>
@@ -23,9 +24,11 @@
 #include <utility>
 #include <vector>
 
+#include "rclcpp/event.hpp"
 #include "rosbag2/types.hpp"
 #include "rosbag2/writer.hpp"
 #include "rosbag2_transport/record_options.hpp"
+#include "topic_filter.hpp"
 
 namespace rosbag2
 {
@@ -46,12 +49,17 @@ public:
   void record(const RecordOptions & record_options);
 
 private:
-  void topics_discovery(
-    std::chrono::milliseconds topic_polling_interval,
-    const std::vector<std::string> & requested_topics = {});
+  // Subscribes to new topics whenever the graph changes. Polls in the given interval instead if
+  // graph events are not available.
+  void topics_discovery(std::chrono::milliseconds topic_polling_interval);
 
-  std::unordered_map<std::string, std::string>
-  get_requested_or_available_topics(const std::vector<std::string> & requested_topics);
+  // Returns the graph event of the node, or nullptr if graph events are not available.
+  rclcpp::Event::SharedPtr get_graph_event() const;
+
+  // Blocks until the graph has changed since the last call or rclcpp is shut down.
+  void wait_for_graph_change(const rclcpp::Event::SharedPtr & graph_event) const;
+
+  std::unordered_map<std::string, std::string> get_requested_or_available_topics();
 
   std::unordered_map<std::string, std::string>
   get_missing_topics(const std::unordered_map<std::string, std::string> & topics);
@@ -62,15 +70,19 @@ private:
   void subscribe_topic(const rosbag2::TopicMetadata & topic);
 
   std::shared_ptr<GenericSubscription> create_subscription(
-    const std::string & topic_name, const std::string & topic_type);
+    const std::string & topic_name, const std::string & topic_type, rosbag2::TopicId topic_id);
 
   void record_messages() const;
 
+  static const std::chrono::seconds graph_event_wait_period_;
+
   std::shared_ptr<rosbag2::Writer> writer_;
   std::shared_ptr<Rosbag2Node> node_;
+  std::unique_ptr<TopicFilter> topic_filter_;
   std::vector<std::shared_ptr<GenericSubscription>> subscriptions_;
   std::unordered_set<std::string> subscribed_topics_;
   std::string serialization_format_;
+  size_t number_of_threads_;
 };
 
 }  // namespace rosbag2_transport
@@ -20,6 +20,7 @@
 #include <string>
 #include <vector>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 
 #include "rcl/expand_topic_name.h"
@@ -43,7 +44,8 @@ std::shared_ptr<GenericPublisher> Rosbag2Node::create_generic_publisher(
 std::shared_ptr<GenericSubscription> Rosbag2Node::create_generic_subscription(
   const std::string & topic,
   const std::string & type,
-  std::function<void(std::shared_ptr<rmw_serialized_message_t>)> callback)
+  std::function<void(std::shared_ptr<rmw_serialized_message_t>)> callback,
+  rclcpp::callback_group::CallbackGroup::SharedPtr callback_group)
 {
   auto type_support = rosbag2::get_typesupport(type, "rosidl_typesupport_cpp");
 
@@ -56,7 +58,7 @@ std::shared_ptr<GenericSubscription> Rosbag2Node::create_generic_subscription(
       topic,
       callback);
 
-    get_node_topics_interface()->add_subscription(subscription, nullptr);
+    get_node_topics_interface()->add_subscription(subscription, callback_group);
   } catch (const std::runtime_error & ex) {
     ROSBAG2_TRANSPORT_LOG_ERROR_STREAM(
       "Error subscribing to topic '" << topic << "'. Error: " << ex.what());
@@ -118,24 +120,44 @@ std::string Rosbag2Node::expand_topic_name(const std::string & topic_name)
   return expanded_topic_name_std;
 }
 
-std::unordered_map<std::string, std::string> Rosbag2Node::get_topics_with_types(
+std::unordered_set<std::string> Rosbag2Node::expand_topic_names(
   const std::vector<std::string> & topic_names)
 {
-  std::vector<std::string> sanitized_topic_names;
+  std::unordered_set<std::string> expanded_topic_names;
   for (const auto & topic_name : topic_names) {
-    auto sanitized_topic_name = expand_topic_name(topic_name);
-    if (!sanitized_topic_name.empty()) {
-      sanitized_topic_names.push_back(sanitized_topic_name);
+    auto expanded_topic_name = expand_topic_name(topic_name);
+    if (!expanded_topic_name.empty()) {
+      expanded_topic_names.insert(std::move(expanded_topic_name));
+    }
+  }
+  return expanded_topic_names;
+}
+
+std::unordered_map<std::string, std::string> Rosbag2Node::get_topics_with_types(
+  const std::vector<std::string> & topic_names)
+{
+  auto sanitized_topic_names = expand_topic_names(topic_names);
+
+  auto topics_and_types = this->get_topic_names_and_types();
+
+  std::map<std::string, std::vector<std::string>> filtered_topics_and_types;
+  for (const auto & topic_and_type : topics_and_types) {
+    if (sanitized_topic_names.find(topic_and_type.first) != sanitized_topic_names.end()) {
+      filtered_topics_and_types.insert(topic_and_type);
     }
   }
 
+  return filter_topics_with_more_than_one_type(filtered_topics_and_types);
+}
+
+std::unordered_map<std::string, std::string> Rosbag2Node::get_selected_topics_with_types(
+  const TopicFilter & topic_filter)
+{
   auto topics_and_types = this->get_topic_names_and_types();
 
   std::map<std::string, std::vector<std::string>> filtered_topics_and_types;
   for (const auto & topic_and_type : topics_and_types) {
-    if (std::find(sanitized_topic_names.begin(), sanitized_topic_names.end(),
-      topic_and_type.first) != sanitized_topic_names.end())
-    {
+    if (topic_filter.is_selected(topic_and_type.first)) {
       filtered_topics_and_types.insert(topic_and_type);
     }
   }
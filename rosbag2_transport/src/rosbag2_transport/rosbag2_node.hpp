@@ -19,6 +19,7 @@
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include "rclcpp/node.hpp"
@@ -26,6 +27,7 @@
 
 #include "generic_publisher.hpp"
 #include "generic_subscription.hpp"
+#include "topic_filter.hpp"
 
 namespace rosbag2_transport
 {
@@ -44,14 +46,23 @@ public:
   create_generic_subscription(
     const std::string & topic,
     const std::string & type,
-    std::function<void(std::shared_ptr<rmw_serialized_message_t>)> callback);
+    std::function<void(std::shared_ptr<rmw_serialized_message_t>)> callback,
+    rclcpp::callback_group::CallbackGroup::SharedPtr callback_group = nullptr);
 
   std::unordered_map<std::string, std::string>
   get_topics_with_types(const std::vector<std::string> & topic_names);
 
+  // Returns the topics with a single type which are selected by the filter.
+  std::unordered_map<std::string, std::string>
+  get_selected_topics_with_types(const TopicFilter & topic_filter);
+
   std::string
   expand_topic_name(const std::string & topic_name);
 
+  // Expands all names, leaving out those which cannot be expanded.
+  std::unordered_set<std::string>
+  expand_topic_names(const std::vector<std::string> & topic_names);
+
   std::unordered_map<std::string, std::string>
   get_all_topics_with_types();
 
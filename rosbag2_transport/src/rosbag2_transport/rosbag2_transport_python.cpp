@@ -37,6 +37,10 @@ rosbag2_transport_record(PyObject * Py_UNUSED(self), PyObject * args, PyObject *
     "no_discovery",
     "polling_interval",
     "topics",
+    "number_of_threads",
+    "regex",
+    "exclude",
+    "defer_indices",
     nullptr};
 
   char * uri = nullptr;
@@ -47,7 +51,11 @@ rosbag2_transport_record(PyObject * Py_UNUSED(self), PyObject * args, PyObject *
   bool no_discovery = false;
   uint64_t polling_interval_ms = 100;
   PyObject * topics = nullptr;
-  if (!PyArg_ParseTupleAndKeywords(args, kwargs, "ssss|bbKO", const_cast<char **>(kwlist),
+  uint64_t number_of_threads = 1;
+  char * regex = nullptr;
+  char * exclude = nullptr;
+  bool defer_indices = false;
+  if (!PyArg_ParseTupleAndKeywords(args, kwargs, "ssss|bbKOKssb", const_cast<char **>(kwlist),
     &uri,
     &storage_id,
     &serilization_format,
@@ -55,17 +63,27 @@ rosbag2_transport_record(PyObject * Py_UNUSED(self), PyObject * args, PyObject *
     &all,
     &no_discovery,
     &polling_interval_ms,
-    &topics))
+    &topics,
+    &number_of_threads,
+    &regex,
+    &exclude,
+    &defer_indices))
   {
     return nullptr;
   }
 
   storage_options.uri = std::string(uri);
   storage_options.storage_id = std::string(storage_id);
+  storage_options.index_creation = defer_indices ?
+    rosbag2_storage::IndexCreation::AFTER_WRITING :
+    rosbag2_storage::IndexCreation::BEFORE_WRITING;
   record_options.all = all;
   record_options.is_discovery_disabled = no_discovery;
   record_options.topic_polling_interval = std::chrono::milliseconds(polling_interval_ms);
   record_options.node_prefix = std::string(node_prefix);
+  record_options.number_of_threads = static_cast<size_t>(number_of_threads);
+  record_options.regex = regex ? regex : "";
+  record_options.exclude = exclude ? exclude : "";
 
   if (topics) {
     PyObject * topic_iterator = PyObject_GetIter(topics);
@@ -102,6 +120,12 @@ rosbag2_transport_play(PyObject * Py_UNUSED(self), PyObject * args, PyObject * k
     "storage_id",
     "node_prefix",
     "read_ahead_queue_size",
+    "topics",
+    "spin_threshold_us",
+    "rate",
+    "max_speed",
+    "read_ahead_queue_bytes",
+    "publishing_threads",
     nullptr
   };
 
@@ -109,11 +133,23 @@ rosbag2_transport_play(PyObject * Py_UNUSED(self), PyObject * args, PyObject * k
   char * storage_id;
   char * node_prefix;
   size_t read_ahead_queue_size;
-  if (!PyArg_ParseTupleAndKeywords(args, kwargs, "sss|k", const_cast<char **>(kwlist),
+  PyObject * topics = nullptr;
+  uint64_t spin_threshold_us = 0;
+  double rate = 1.0;
+  bool max_speed = false;
+  uint64_t read_ahead_queue_bytes = 0;
+  uint64_t publishing_threads = 1;
+  if (!PyArg_ParseTupleAndKeywords(args, kwargs, "sss|kOKdbKK", const_cast<char **>(kwlist),
     &uri,
     &storage_id,
     &node_prefix,
-    &read_ahead_queue_size))
+    &read_ahead_queue_size,
+    &topics,
+    &spin_threshold_us,
+    &rate,
+    &max_speed,
+    &read_ahead_queue_bytes,
+    &publishing_threads))
   {
     return nullptr;
   }
@@ -123,6 +159,24 @@ rosbag2_transport_play(PyObject * Py_UNUSED(self), PyObject * args, PyObject * k
 
   play_options.node_prefix = std::string(node_prefix);
   play_options.read_ahead_queue_size = read_ahead_queue_size;
+  play_options.spin_threshold = std::chrono::microseconds(spin_threshold_us);
+  play_options.rate = rate;
+  play_options.max_speed = max_speed;
+  play_options.read_ahead_queue_bytes = read_ahead_queue_bytes;
+  play_options.publishing_threads = static_cast<size_t>(publishing_threads);
+
+  if (topics) {
+    PyObject * topic_iterator = PyObject_GetIter(topics);
+    if (topic_iterator != nullptr) {
+      PyObject * topic;
+      while ((topic = PyIter_Next(topic_iterator))) {
+        play_options.topics_to_filter.emplace_back(PyUnicode_AsUTF8(topic));
+
+        Py_DECREF(topic);
+      }
+      Py_DECREF(topic_iterator);
+    }
+  }
 
   rosbag2_transport::Rosbag2Transport transport;
   transport.init();
@@ -0,0 +1,84 @@
+// Copyright 2018, Bosch Software Innovations GmbH.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "topic_filter.hpp"
+
+#include <regex>
+#include <string>
+#include <unordered_set>
+#include <utility>
+
+#include "rosbag2_transport/logging.hpp"
+
+namespace rosbag2_transport
+{
+
+namespace
+{
+std::regex compile_regex(const std::string & regex)
+{
+  return regex.empty() ?
+         std::regex() :
+         std::regex(regex, std::regex::ECMAScript | std::regex::optimize);
+}
+}  // namespace
+
+TopicFilter::TopicFilter(
+  std::unordered_set<std::string> topic_names,
+  const std::string & include_regex,
+  const std::string & exclude_regex)
+: topic_names_(std::move(topic_names)),
+  has_topic_names_(!topic_names_.empty()),
+  has_include_regex_(!include_regex.empty()),
+  include_regex_(compile_regex(include_regex)),
+  has_exclude_regex_(!exclude_regex.empty()),
+  exclude_regex_(compile_regex(exclude_regex))
+{
+  if (!has_exclude_regex_) {
+    return;
+  }
+  for (auto topic_name = topic_names_.begin(); topic_name != topic_names_.end(); ) {
+    if (std::regex_match(*topic_name, exclude_regex_)) {
+      ROSBAG2_TRANSPORT_LOG_WARN_STREAM(
+        "Topic '" << *topic_name << "' matches the exclude regex and will not be recorded.");
+      topic_name = topic_names_.erase(topic_name);
+    } else {
+      ++topic_name;
+    }
+  }
+}
+
+bool TopicFilter::is_selected(const std::string & topic_name) const
+{
+  if (has_exclude_regex_ && std::regex_match(topic_name, exclude_regex_)) {
+    return false;
+  }
+  if (!has_topic_names_ && !has_include_regex_) {
+    return true;
+  }
+  return topic_names_.find(topic_name) != topic_names_.end() ||
+         (has_include_regex_ && std::regex_match(topic_name, include_regex_));
+}
+
+bool TopicFilter::selects_fixed_topics() const
+{
+  return has_topic_names_ && !has_include_regex_;
+}
+
+const std::unordered_set<std::string> & TopicFilter::get_topic_names() const
+{
+  return topic_names_;
+}
+
+}  // namespace rosbag2_transport
@@ -0,0 +1,64 @@
+// Copyright 2018, Bosch Software Innovations GmbH.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROSBAG2_TRANSPORT__TOPIC_FILTER_HPP_
+#define ROSBAG2_TRANSPORT__TOPIC_FILTER_HPP_
+
+#include <regex>
+#include <string>
+#include <unordered_set>
+
+namespace rosbag2_transport
+{
+
+/**
+ * Decides which topics are recorded. A topic is selected if it is one of the given topic names or
+ * matches the include regex, unless it matches the exclude regex. Without topic names and include
+ * regex, all topics are selected. Empty regexes are ignored.
+ *
+ * Topic names are expected to be fully expanded. The regexes are compiled once on construction,
+ * so that selecting a topic costs a hash lookup and at most two regex matches. Given topic names
+ * matching the exclude regex can never be selected and are dropped with a warning.
+ */
+class TopicFilter
+{
+public:
+  /**
+   * \throws std::regex_error if one of the regexes is invalid.
+   */
+  TopicFilter(
+    std::unordered_set<std::string> topic_names,
+    const std::string & include_regex,
+    const std::string & exclude_regex);
+
+  bool is_selected(const std::string & topic_name) const;
+
+  // True if only the given topic names can be selected, i.e. there is no include regex.
+  bool selects_fixed_topics() const;
+
+  // The given topic names which can be selected, i.e. which do not match the exclude regex.
+  const std::unordered_set<std::string> & get_topic_names() const;
+
+private:
+  std::unordered_set<std::string> topic_names_;
+  bool has_topic_names_;
+  bool has_include_regex_;
+  std::regex include_regex_;
+  bool has_exclude_regex_;
+  std::regex exclude_regex_;
+};
+
+}  // namespace rosbag2_transport
+
+#endif  // ROSBAG2_TRANSPORT__TOPIC_FILTER_HPP_
@@ -15,8 +15,13 @@
 #ifndef ROSBAG2_TRANSPORT__MOCK_SEQUENTIAL_READER_HPP_
 #define ROSBAG2_TRANSPORT__MOCK_SEQUENTIAL_READER_HPP_
 
+#include <algorithm>
+#include <chrono>
+#include <limits>
 #include <memory>
+#include <stdexcept>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -35,14 +40,38 @@ public:
 
   bool has_next() override
   {
+    skip_filtered_messages();
     return num_read_ < messages_.size();
   }
 
   std::shared_ptr<rosbag2::SerializedBagMessage> read_next() override
   {
+    skip_filtered_messages();
+    std::this_thread::sleep_for(read_delay_);
+    if (num_read_ == failing_message_index_) {
+      throw std::runtime_error("Failed to read message " + std::to_string(num_read_));
+    }
     return messages_[num_read_++];
   }
 
+  void set_filter(const rosbag2::StorageFilter & storage_filter) override
+  {
+    filter_ = storage_filter;
+  }
+
+  void reset_filter() override
+  {
+    filter_ = rosbag2::StorageFilter();
+  }
+
+  void seek(const rcutils_time_point_value_t & timestamp) override
+  {
+    num_read_ = 0;
+    while (num_read_ < messages_.size() && messages_[num_read_]->time_stamp < timestamp) {
+      ++num_read_;
+    }
+  }
+
   std::vector<rosbag2::TopicMetadata> get_all_topics_and_types() override
   {
     return topics_;
@@ -56,10 +85,35 @@ public:
     topics_ = std::move(topics);
   }
 
+  // Makes reading the message with the given index throw, like a broken storage or converter
+  void set_read_failure(size_t failing_message_index)
+  {
+    failing_message_index_ = failing_message_index;
+  }
+
+  // Makes reading every message take the given time, like a slow storage
+  void set_read_delay(std::chrono::milliseconds read_delay)
+  {
+    read_delay_ = read_delay;
+  }
+
 private:
+  void skip_filtered_messages()
+  {
+    const auto & topics = filter_.topics;
+    while (num_read_ < messages_.size() && !topics.empty() &&
+      std::find(topics.begin(), topics.end(), messages_[num_read_]->topic_name) == topics.end())
+    {
+      ++num_read_;
+    }
+  }
+
   std::vector<std::shared_ptr<rosbag2::SerializedBagMessage>> messages_;
   std::vector<rosbag2::TopicMetadata> topics_;
-  size_t num_read_;
+  size_t num_read_ = 0;
+  rosbag2::StorageFilter filter_;
+  std::chrono::milliseconds read_delay_{0};
+  size_t failing_message_index_ = std::numeric_limits<size_t>::max();
 };
 
 #endif  // ROSBAG2_TRANSPORT__MOCK_SEQUENTIAL_READER_HPP_
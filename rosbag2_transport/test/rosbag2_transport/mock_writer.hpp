@@ -16,6 +16,7 @@
 #define ROSBAG2_TRANSPORT__MOCK_WRITER_HPP_
 
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -33,34 +34,59 @@ public:
     (void) converter_options;
   }
 
-  void create_topic(const rosbag2::TopicMetadata & topic_with_type) override
+  rosbag2::TopicId create_topic(const rosbag2::TopicMetadata & topic_with_type) override
   {
+    std::lock_guard<std::mutex> lock(mutex_);
     topics_.emplace(topic_with_type.name, topic_with_type);
+    topic_names_.push_back(topic_with_type.name);
+    return static_cast<rosbag2::TopicId>(topic_names_.size() - 1);
   }
 
   void write(std::shared_ptr<rosbag2::SerializedBagMessage> message) override
   {
+    std::lock_guard<std::mutex> lock(mutex_);
     messages_.push_back(message);
     messages_per_topic_[message->topic_name] += 1;
   }
 
+  void write(
+    rosbag2::TopicId topic_id,
+    std::shared_ptr<rcutils_uint8_array_t> serialized_data,
+    rcutils_time_point_value_t time_stamp) override
+  {
+    auto message = std::make_shared<rosbag2::SerializedBagMessage>();
+    message->serialized_data = serialized_data;
+    message->time_stamp = time_stamp;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      message->topic_name = topic_names_.at(topic_id);
+    }
+    write(message);
+  }
+
   std::vector<std::shared_ptr<rosbag2::SerializedBagMessage>> get_messages()
   {
+    std::lock_guard<std::mutex> lock(mutex_);
     return messages_;
   }
 
   std::unordered_map<std::string, size_t> messages_per_topic()
   {
+    std::lock_guard<std::mutex> lock(mutex_);
     return messages_per_topic_;
   }
 
   std::unordered_map<std::string, rosbag2::TopicMetadata> get_topics()
   {
+    std::lock_guard<std::mutex> lock(mutex_);
     return topics_;
   }
 
 private:
+  // Subscriptions may write concurrently when recording with several threads
+  std::mutex mutex_;
   std::unordered_map<std::string, rosbag2::TopicMetadata> topics_;
+  std::vector<std::string> topic_names_;
   std::vector<std::shared_ptr<rosbag2::SerializedBagMessage>> messages_;
   std::unordered_map<std::string, size_t> messages_per_topic_;
 };
@@ -104,3 +104,159 @@ TEST_F(RosBag2PlayTestFixture, recorded_messages_are_played_for_all_topics)
     Each(Pointee(Field(&test_msgs::msg::Arrays::float32_values,
     ElementsAre(40.0f, 2.0f, 0.0f)))));
 }
+
+TEST_F(RosBag2PlayTestFixture, recorded_messages_are_played_for_filtered_topics)
+{
+  auto primitive_message1 = get_messages_basic_types()[0];
+  primitive_message1->int32_value = 42;
+
+  auto complex_message1 = get_messages_arrays()[0];
+  complex_message1->float32_values = {{40.0f, 2.0f, 0.0f}};
+  complex_message1->bool_values = {{true, false, true}};
+
+  auto topic_types = std::vector<rosbag2::TopicMetadata>{
+    {"topic1", "test_msgs/BasicTypes", ""},
+    {"topic2", "test_msgs/Arrays", ""},
+  };
+
+  std::vector<std::shared_ptr<rosbag2::SerializedBagMessage>> messages =
+  {serialize_test_message("topic1", 500, primitive_message1),
+    serialize_test_message("topic1", 700, primitive_message1),
+    serialize_test_message("topic1", 900, primitive_message1),
+    serialize_test_message("topic2", 550, complex_message1),
+    serialize_test_message("topic2", 750, complex_message1),
+    serialize_test_message("topic2", 950, complex_message1)};
+
+  reader_->prepare(messages, topic_types);
+
+  sub_->add_subscription<test_msgs::msg::BasicTypes>("/topic1", 0);
+  sub_->add_subscription<test_msgs::msg::Arrays>("/topic2", 2);
+
+  auto await_received_messages = sub_->spin_subscriptions();
+
+  play_options_.topics_to_filter = {"topic2"};
+  Rosbag2Transport rosbag2_transport(reader_, writer_, info_);
+  rosbag2_transport.play(storage_options_, play_options_);
+
+  await_received_messages.get();
+
+  auto replayed_test_primitives = sub_->get_received_messages<test_msgs::msg::BasicTypes>(
+    "/topic1");
+  EXPECT_THAT(replayed_test_primitives, IsEmpty());
+
+  auto replayed_test_arrays = sub_->get_received_messages<test_msgs::msg::Arrays>(
+    "/topic2");
+  EXPECT_THAT(replayed_test_arrays, SizeIs(Ge(2u)));
+}
+
+TEST_F(RosBag2PlayTestFixture, all_messages_are_played_with_read_ahead_queue_smaller_than_bag)
+{
+  auto primitive_message1 = get_messages_basic_types()[0];
+  primitive_message1->int32_value = 42;
+
+  auto topic_types = std::vector<rosbag2::TopicMetadata>{
+    {"topic1", "test_msgs/BasicTypes", ""},
+  };
+
+  std::vector<std::shared_ptr<rosbag2::SerializedBagMessage>> messages;
+  for (int64_t i = 0; i < 6; ++i) {
+    messages.push_back(serialize_test_message("topic1", 500 + 100 * i, primitive_message1));
+  }
+
+  reader_->prepare(messages, topic_types);
+
+  sub_->add_subscription<test_msgs::msg::BasicTypes>("/topic1", 5);
+
+  auto await_received_messages = sub_->spin_subscriptions();
+
+  play_options_.read_ahead_queue_size = 2;
+  Rosbag2Transport rosbag2_transport(reader_, writer_, info_);
+  rosbag2_transport.play(storage_options_, play_options_);
+
+  await_received_messages.get();
+
+  auto replayed_test_primitives = sub_->get_received_messages<test_msgs::msg::BasicTypes>(
+    "/topic1");
+  EXPECT_THAT(replayed_test_primitives, SizeIs(Ge(5u)));
+}
+
+TEST_F(RosBag2PlayTestFixture, all_messages_are_played_with_read_ahead_queue_bounded_by_bytes)
+{
+  auto primitive_message1 = get_messages_basic_types()[0];
+  primitive_message1->int32_value = 42;
+
+  auto topic_types = std::vector<rosbag2::TopicMetadata>{
+    {"topic1", "test_msgs/BasicTypes", ""},
+  };
+
+  std::vector<std::shared_ptr<rosbag2::SerializedBagMessage>> messages;
+  for (int64_t i = 0; i < 6; ++i) {
+    messages.push_back(serialize_test_message("topic1", 500 + 100 * i, primitive_message1));
+  }
+
+  reader_->prepare(messages, topic_types);
+
+  sub_->add_subscription<test_msgs::msg::BasicTypes>("/topic1", 5);
+
+  auto await_received_messages = sub_->spin_subscriptions();
+
+  // Smaller than a single message, which is then read ahead on its own
+  play_options_.read_ahead_queue_size = 0;
+  play_options_.read_ahead_queue_bytes = 1;
+  Rosbag2Transport rosbag2_transport(reader_, writer_, info_);
+  rosbag2_transport.play(storage_options_, play_options_);
+
+  await_received_messages.get();
+
+  auto replayed_test_primitives = sub_->get_received_messages<test_msgs::msg::BasicTypes>(
+    "/topic1");
+  EXPECT_THAT(replayed_test_primitives, SizeIs(Ge(5u)));
+}
+
+TEST_F(RosBag2PlayTestFixture, recorded_messages_are_played_with_several_publishing_threads)
+{
+  auto primitive_message1 = get_messages_basic_types()[0];
+  primitive_message1->int32_value = 42;
+
+  auto complex_message1 = get_messages_arrays()[0];
+  complex_message1->bool_values = {{true, false, true}};
+
+  auto topic_types = std::vector<rosbag2::TopicMetadata>{
+    {"topic1", "test_msgs/BasicTypes", ""},
+    {"topic2", "test_msgs/Arrays", ""},
+  };
+
+  std::vector<std::shared_ptr<rosbag2::SerializedBagMessage>> messages =
+  {serialize_test_message("topic1", 500, primitive_message1),
+    serialize_test_message("topic1", 700, primitive_message1),
+    serialize_test_message("topic1", 900, primitive_message1),
+    serialize_test_message("topic2", 550, complex_message1),
+    serialize_test_message("topic2", 750, complex_message1),
+    serialize_test_message("topic2", 950, complex_message1)};
+
+  reader_->prepare(messages, topic_types);
+
+  sub_->add_subscription<test_msgs::msg::BasicTypes>("/topic1", 2);
+  sub_->add_subscription<test_msgs::msg::Arrays>("/topic2", 2);
+
+  auto await_received_messages = sub_->spin_subscriptions();
+
+  play_options_.publishing_threads = 2;
+  Rosbag2Transport rosbag2_transport(reader_, writer_, info_);
+  rosbag2_transport.play(storage_options_, play_options_);
+
+  await_received_messages.get();
+
+  auto replayed_test_primitives = sub_->get_received_messages<test_msgs::msg::BasicTypes>(
+    "/topic1");
+  EXPECT_THAT(replayed_test_primitives, SizeIs(Ge(2u)));
+  EXPECT_THAT(replayed_test_primitives,
+    Each(Pointee(Field(&test_msgs::msg::BasicTypes::int32_value, 42))));
+
+  auto replayed_test_arrays = sub_->get_received_messages<test_msgs::msg::Arrays>(
+    "/topic2");
+  EXPECT_THAT(replayed_test_arrays, SizeIs(Ge(2u)));
+  EXPECT_THAT(replayed_test_arrays,
+    Each(Pointee(Field(&test_msgs::msg::Arrays::bool_values,
+    ElementsAre(true, false, true)))));
+}
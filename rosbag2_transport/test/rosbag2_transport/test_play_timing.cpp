@@ -61,3 +61,112 @@ TEST_F(Rosbag2TransportTestFixture, playing_respects_relative_timing_of_stored_m
   ASSERT_THAT(replay_time, Gt(message_time_difference));
   rclcpp::shutdown();
 }
+
+TEST_F(Rosbag2TransportTestFixture, playing_with_spin_threshold_respects_relative_timing)
+{
+  rclcpp::init(0, nullptr);
+  auto primitive_message = get_messages_strings()[0];
+  primitive_message->string_value = "Hello World";
+
+  auto message_time_difference = std::chrono::milliseconds(200);
+  auto topics_and_types =
+    std::vector<rosbag2::TopicMetadata>{{"topic1", "test_msgs/Strings", ""}};
+  std::vector<std::shared_ptr<rosbag2::SerializedBagMessage>> messages =
+  {serialize_test_message("topic1", 0, primitive_message),
+    serialize_test_message("topic1", 0, primitive_message)};
+
+  messages[0]->time_stamp = 100;
+  messages[1]->time_stamp =
+    messages[0]->time_stamp + std::chrono::nanoseconds(message_time_difference).count();
+
+  reader_->prepare(messages, topics_and_types);
+
+  play_options_.spin_threshold = std::chrono::milliseconds(1);
+  auto start = std::chrono::steady_clock::now();
+  Rosbag2Transport rosbag2_transport(reader_, writer_, info_);
+  rosbag2_transport.play(storage_options_, play_options_);
+  auto replay_time = std::chrono::steady_clock::now() - start;
+
+  ASSERT_THAT(replay_time, Gt(message_time_difference));
+  rclcpp::shutdown();
+}
+
+TEST_F(Rosbag2TransportTestFixture, playing_at_max_speed_does_not_wait_for_timing_of_messages)
+{
+  rclcpp::init(0, nullptr);
+  auto primitive_message = get_messages_strings()[0];
+  primitive_message->string_value = "Hello World";
+
+  auto message_time_difference = std::chrono::seconds(5);
+  auto topics_and_types =
+    std::vector<rosbag2::TopicMetadata>{{"topic1", "test_msgs/Strings", ""}};
+  std::vector<std::shared_ptr<rosbag2::SerializedBagMessage>> messages =
+  {serialize_test_message("topic1", 0, primitive_message),
+    serialize_test_message("topic1", 0, primitive_message)};
+
+  messages[0]->time_stamp = 100;
+  messages[1]->time_stamp =
+    messages[0]->time_stamp + std::chrono::nanoseconds(message_time_difference).count();
+
+  reader_->prepare(messages, topics_and_types);
+
+  play_options_.max_speed = true;
+  auto start = std::chrono::steady_clock::now();
+  Rosbag2Transport rosbag2_transport(reader_, writer_, info_);
+  rosbag2_transport.play(storage_options_, play_options_);
+  auto replay_time = std::chrono::steady_clock::now() - start;
+
+  ASSERT_THAT(replay_time, Lt(message_time_difference));
+  rclcpp::shutdown();
+}
+
+TEST_F(Rosbag2TransportTestFixture, playing_at_max_speed_does_not_warn_about_slow_loading)
+{
+  rclcpp::init(0, nullptr);
+  auto primitive_message = get_messages_strings()[0];
+  auto topics_and_types =
+    std::vector<rosbag2::TopicMetadata>{{"topic1", "test_msgs/Strings", ""}};
+  std::vector<std::shared_ptr<rosbag2::SerializedBagMessage>> messages;
+  for (int64_t milliseconds = 0; milliseconds < 20; ++milliseconds) {
+    messages.push_back(serialize_test_message("topic1", milliseconds, primitive_message));
+  }
+
+  reader_->prepare(messages, topics_and_types);
+  reader_->set_read_delay(std::chrono::milliseconds(5));
+
+  play_options_.max_speed = true;
+  play_options_.read_ahead_queue_size = 1;
+  internal::CaptureStderr();
+  Rosbag2Transport rosbag2_transport(reader_, writer_, info_);
+  rosbag2_transport.play(storage_options_, play_options_);
+  auto error_output = internal::GetCapturedStderr();
+
+  EXPECT_THAT(error_output, Not(HasSubstr("Message queue starved")));
+  rclcpp::shutdown();
+}
+
+TEST_F(Rosbag2TransportTestFixture, playing_warns_once_if_messages_are_due_before_being_loaded)
+{
+  rclcpp::init(0, nullptr);
+  auto primitive_message = get_messages_strings()[0];
+  auto topics_and_types =
+    std::vector<rosbag2::TopicMetadata>{{"topic1", "test_msgs/Strings", ""}};
+  std::vector<std::shared_ptr<rosbag2::SerializedBagMessage>> messages;
+  for (int i = 0; i < 10; ++i) {
+    messages.push_back(serialize_test_message("topic1", 0, primitive_message));
+  }
+
+  reader_->prepare(messages, topics_and_types);
+  reader_->set_read_delay(std::chrono::milliseconds(5));
+
+  play_options_.read_ahead_queue_size = 1;
+  internal::CaptureStderr();
+  Rosbag2Transport rosbag2_transport(reader_, writer_, info_);
+  rosbag2_transport.play(storage_options_, play_options_);
+  auto error_output = internal::GetCapturedStderr();
+
+  auto first_warning = error_output.find("Message queue starved");
+  ASSERT_THAT(first_warning, Ne(std::string::npos));
+  EXPECT_THAT(error_output.find("Message queue starved", first_warning + 1), Eq(std::string::npos));
+  rclcpp::shutdown();
+}
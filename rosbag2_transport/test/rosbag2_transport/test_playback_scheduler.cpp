@@ -0,0 +1,112 @@
+// Copyright 2018, Bosch Software Innovations GmbH.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gmock/gmock.h>
+
+#include <chrono>
+#include <stdexcept>
+
+#include "../../src/rosbag2_transport/playback_scheduler.hpp"
+
+using namespace ::testing;  // NOLINT
+using namespace std::chrono_literals;  // NOLINT
+using rosbag2_transport::PlaybackScheduler;
+
+TEST(PlaybackSchedulerTest, wait_until_does_not_return_before_scheduled_time) {
+  for (std::chrono::microseconds spin_threshold : {0us, 500us, 20000us}) {
+    PlaybackScheduler scheduler(spin_threshold);
+    auto start = PlaybackScheduler::Clock::now();
+    scheduler.start();
+    scheduler.wait_until(10ms);
+    scheduler.wait_until(5ms);
+
+    EXPECT_THAT(PlaybackScheduler::Clock::now() - start, Ge(10ms));
+  }
+}
+
+TEST(PlaybackSchedulerTest, lateness_is_sorted_into_power_of_two_microsecond_buckets) {
+  PlaybackScheduler scheduler;
+  scheduler.record_lateness(-5us);
+  scheduler.record_lateness(500ns);
+  scheduler.record_lateness(1us);
+  scheduler.record_lateness(3us);
+  scheduler.record_lateness(100us);
+  scheduler.record_lateness(10s);
+
+  const auto & histogram = scheduler.get_lateness_histogram();
+  EXPECT_THAT(histogram[0], Eq(2u));
+  EXPECT_THAT(histogram[1], Eq(1u));
+  EXPECT_THAT(histogram[2], Eq(1u));
+  EXPECT_THAT(histogram[7], Eq(1u));
+  EXPECT_THAT(histogram.back(), Eq(1u));
+  EXPECT_THAT(scheduler.get_message_count(), Eq(6u));
+  EXPECT_THAT(scheduler.get_max_lateness(), Eq(10s));
+}
+
+TEST(PlaybackSchedulerTest, format_lateness_histogram_lists_non_empty_buckets) {
+  PlaybackScheduler scheduler;
+  scheduler.record_lateness(3us);
+  scheduler.record_lateness(5us);
+
+  EXPECT_THAT(
+    scheduler.format_lateness_histogram(),
+    StrEq("Publish lateness of 2 messages: mean 4 us, max 5 us\n  < 4 us: 1\n  < 8 us: 1"));
+}
+
+TEST(PlaybackSchedulerTest, published_messages_are_recorded_with_their_lateness) {
+  PlaybackScheduler scheduler;
+  scheduler.start();
+  scheduler.wait_until(1ms);
+  scheduler.record_publish(1ms);
+  scheduler.record_publish(-1s);
+
+  EXPECT_THAT(scheduler.get_message_count(), Eq(2u));
+  EXPECT_THAT(scheduler.get_max_lateness(), Ge(1s));
+}
+
+TEST(PlaybackSchedulerTest, wait_until_scales_time_by_rate) {
+  PlaybackScheduler fast_scheduler(0us, 4.0);
+  auto start = PlaybackScheduler::Clock::now();
+  fast_scheduler.start();
+  fast_scheduler.wait_until(40ms);
+  auto fast_wait_time = PlaybackScheduler::Clock::now() - start;
+
+  EXPECT_THAT(fast_wait_time, Ge(10ms));
+  EXPECT_THAT(fast_wait_time, Lt(40ms));
+
+  PlaybackScheduler slow_scheduler(0us, 0.5);
+  start = PlaybackScheduler::Clock::now();
+  slow_scheduler.start();
+  slow_scheduler.wait_until(10ms);
+
+  EXPECT_THAT(PlaybackScheduler::Clock::now() - start, Ge(20ms));
+}
+
+TEST(PlaybackSchedulerTest, throws_if_rate_is_not_positive) {
+  EXPECT_THROW(PlaybackScheduler(0us, 0.0), std::runtime_error);
+  EXPECT_THROW(PlaybackScheduler(0us, -1.0), std::runtime_error);
+}
+
+TEST(PlaybackSchedulerTest, merge_lateness_adds_lateness_of_other_scheduler) {
+  PlaybackScheduler scheduler;
+  scheduler.record_lateness(3us);
+  PlaybackScheduler other_scheduler = scheduler;
+  other_scheduler.record_lateness(5ms);
+
+  scheduler.merge_lateness(other_scheduler);
+
+  EXPECT_THAT(scheduler.get_message_count(), Eq(3u));
+  EXPECT_THAT(scheduler.get_lateness_histogram()[2], Eq(2u));
+  EXPECT_THAT(scheduler.get_max_lateness(), Eq(5ms));
+}
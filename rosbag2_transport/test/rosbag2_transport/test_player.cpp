@@ -0,0 +1,122 @@
+// Copyright 2018, Bosch Software Innovations GmbH.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gmock/gmock.h>
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "rclcpp/rclcpp.hpp"
+#include "test_msgs/message_fixtures.hpp"
+
+#include "../../src/rosbag2_transport/player.hpp"
+#include "../../src/rosbag2_transport/rosbag2_node.hpp"
+#include "rosbag2_transport_test_fixture.hpp"
+
+using namespace ::testing;  // NOLINT
+using namespace rosbag2_transport;  // NOLINT
+
+namespace
+{
+
+// Takes a millisecond to publish a message of slow_topic and records when the others are published
+class SlowTopicPlayer : public Player
+{
+public:
+  SlowTopicPlayer(
+    std::shared_ptr<rosbag2::SequentialReader> reader, std::shared_ptr<Rosbag2Node> node)
+  : Player(std::move(reader), std::move(node)) {}
+
+  // Only written by the thread publishing fast_topic
+  std::vector<std::chrono::steady_clock::time_point> fast_publish_times;
+
+protected:
+  void publish(const ReplayableMessage & message) override
+  {
+    if (message.message->topic_name == "slow_topic") {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    } else {
+      fast_publish_times.push_back(std::chrono::steady_clock::now());
+    }
+    Player::publish(message);
+  }
+};
+
+}  // namespace
+
+TEST_F(Rosbag2TransportTestFixture, slow_topic_does_not_delay_topics_of_other_publishing_threads)
+{
+  rclcpp::init(0, nullptr);
+  auto primitive_message = get_messages_strings()[0];
+  auto topics_and_types = std::vector<rosbag2::TopicMetadata>{
+    {"slow_topic", "test_msgs/Strings", ""}, {"fast_topic", "test_msgs/Strings", ""}};
+
+  // The slow topic falls behind by more than half a second, the fast one is due every 2 ms. The
+  // bag exceeds the default read-ahead queue, while the backlog of the slow topic fits into it.
+  const auto fast_period = std::chrono::milliseconds(2);
+  std::vector<std::shared_ptr<rosbag2::SerializedBagMessage>> messages;
+  for (int64_t i = 0; i < 600; ++i) {
+    messages.push_back(serialize_test_message("slow_topic", 0, primitive_message));
+    messages.back()->time_stamp = i * 50000;
+  }
+  for (int64_t i = 0; i < 500; ++i) {
+    messages.push_back(serialize_test_message("fast_topic", 0, primitive_message));
+    messages.back()->time_stamp = i * std::chrono::nanoseconds(fast_period).count();
+  }
+  std::stable_sort(messages.begin(), messages.end(),
+    [](const auto & lhs, const auto & rhs) {return lhs->time_stamp < rhs->time_stamp;});
+  reader_->prepare(messages, topics_and_types);
+
+  play_options_.publishing_threads = 2;
+  SlowTopicPlayer player(reader_, std::make_shared<Rosbag2Node>("rosbag2_test_player"));
+  player.play(play_options_);
+
+  ASSERT_THAT(play_options_.read_ahead_queue_size, Eq(1000u));
+  ASSERT_THAT(player.fast_publish_times, SizeIs(500));
+  for (size_t i = 1; i < player.fast_publish_times.size(); ++i) {
+    auto lateness =
+      player.fast_publish_times[i] - player.fast_publish_times[0] -
+      static_cast<int64_t>(i) * fast_period;
+    EXPECT_THAT(lateness, Lt(std::chrono::milliseconds(100)));
+  }
+  rclcpp::shutdown();
+}
+
+TEST_F(Rosbag2TransportTestFixture, read_errors_stop_publishing_threads_and_fail_playback)
+{
+  rclcpp::init(0, nullptr);
+  auto primitive_message = get_messages_strings()[0];
+  auto topics_and_types = std::vector<rosbag2::TopicMetadata>{
+    {"topic1", "test_msgs/Strings", ""}, {"topic2", "test_msgs/Strings", ""}};
+  std::vector<std::shared_ptr<rosbag2::SerializedBagMessage>> messages;
+  for (int64_t i = 0; i < 100; ++i) {
+    messages.push_back(
+      serialize_test_message(i % 2 == 0 ? "topic1" : "topic2", i, primitive_message));
+  }
+  reader_->prepare(messages, topics_and_types);
+  reader_->set_read_failure(50);
+
+  // The failure happens after the publishing threads started on the first messages read ahead
+  play_options_.read_ahead_queue_size = 10;
+  play_options_.publishing_threads = 2;
+  Player player(reader_, std::make_shared<Rosbag2Node>("rosbag2_test_player"));
+
+  EXPECT_THROW(player.play(play_options_), std::runtime_error);
+  rclcpp::shutdown();
+}
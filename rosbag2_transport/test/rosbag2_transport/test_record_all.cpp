@@ -52,3 +52,30 @@ TEST_F(RecordIntegrationTestFixture, published_messages_from_multiple_topics_are
   EXPECT_THAT(array_messages[0]->bool_values, ElementsAre(true, false, true));
   EXPECT_THAT(array_messages[0]->float32_values, ElementsAre(40.0f, 2.0f, 0.0f));
 }
+
+TEST_F(RecordIntegrationTestFixture, messages_of_multiple_topics_are_recorded_with_several_threads)
+{
+  auto string_message = get_messages_strings()[0];
+  string_message->string_value = "Hello World";
+  std::string first_topic = "/first_string_topic";
+  std::string second_topic = "/second_string_topic";
+
+  pub_man_.add_publisher<test_msgs::msg::Strings>(first_topic, string_message, 3);
+  pub_man_.add_publisher<test_msgs::msg::Strings>(second_topic, string_message, 3);
+
+  RecordOptions record_options{true, false, {}, "rmw_format", 100ms};
+  record_options.number_of_threads = 2;
+  start_recording(record_options);
+  run_publishers();
+  stop_recording();
+
+  auto recorded_messages = writer_->get_messages();
+
+  ASSERT_THAT(recorded_messages, SizeIs(6));
+  auto first_messages = filter_messages<test_msgs::msg::Strings>(recorded_messages, first_topic);
+  auto second_messages = filter_messages<test_msgs::msg::Strings>(
+    recorded_messages, second_topic);
+  ASSERT_THAT(first_messages, SizeIs(3));
+  ASSERT_THAT(second_messages, SizeIs(3));
+  EXPECT_THAT(second_messages[2]->string_value, Eq("Hello World"));
+}
@@ -186,3 +186,23 @@ TEST_F(RosBag2NodeFixture, get_all_topics_with_types_returns_all_topics)
   EXPECT_THAT(topics_and_types.find(second_topic)->second, StrEq("test_msgs/msg/Strings"));
   EXPECT_THAT(topics_and_types.find(third_topic)->second, StrEq("test_msgs/msg/Strings"));
 }
+
+TEST_F(RosBag2NodeFixture, get_selected_topics_with_types_returns_topics_selected_by_filter)
+{
+  std::string first_topic("/string_topic");
+  std::string second_topic("/other_topic");
+  std::string third_topic("/wrong_topic");
+
+  create_publisher(first_topic);
+  create_publisher(second_topic);
+  create_publisher(third_topic);
+
+  sleep_to_allow_topics_discovery();
+  rosbag2_transport::TopicFilter topic_filter(
+    node_->expand_topic_names({"string_topic"}), "/.*_topic", "/wrong_.*");
+  auto topics_and_types = node_->get_selected_topics_with_types(topic_filter);
+
+  ASSERT_THAT(topics_and_types, SizeIs(2));
+  EXPECT_THAT(topics_and_types.find(first_topic)->second, StrEq("test_msgs/msg/Strings"));
+  EXPECT_THAT(topics_and_types.find(second_topic)->second, StrEq("test_msgs/msg/Strings"));
+}
@@ -0,0 +1,74 @@
+// Copyright 2018, Bosch Software Innovations GmbH.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gmock/gmock.h>
+
+#include <regex>
+
+#include "../../src/rosbag2_transport/topic_filter.hpp"
+
+using namespace ::testing;  // NOLINT
+using rosbag2_transport::TopicFilter;
+
+TEST(TopicFilterTest, selects_all_topics_without_topic_names_and_regexes) {
+  TopicFilter filter({}, "", "");
+
+  EXPECT_TRUE(filter.is_selected("/any_topic"));
+  EXPECT_FALSE(filter.selects_fixed_topics());
+}
+
+TEST(TopicFilterTest, selects_only_given_topic_names) {
+  TopicFilter filter({"/topic", "/other_topic"}, "", "");
+
+  EXPECT_TRUE(filter.is_selected("/topic"));
+  EXPECT_TRUE(filter.is_selected("/other_topic"));
+  EXPECT_FALSE(filter.is_selected("/topic/sub_topic"));
+  EXPECT_TRUE(filter.selects_fixed_topics());
+}
+
+TEST(TopicFilterTest, selects_topics_matching_include_regex_in_addition_to_topic_names) {
+  TopicFilter filter({"/topic"}, "/camera/.*", "");
+
+  EXPECT_TRUE(filter.is_selected("/topic"));
+  EXPECT_TRUE(filter.is_selected("/camera/image_raw"));
+  EXPECT_FALSE(filter.is_selected("/lidar/points"));
+  EXPECT_FALSE(filter.is_selected("/my/camera/image_raw"));
+  EXPECT_FALSE(filter.selects_fixed_topics());
+}
+
+TEST(TopicFilterTest, does_not_select_topics_matching_exclude_regex) {
+  TopicFilter all_but_raw_images({}, "", ".*/image_raw");
+  TopicFilter listed_but_raw_images({"/camera/image_raw", "/camera/info"}, "", ".*/image_raw");
+
+  EXPECT_FALSE(all_but_raw_images.is_selected("/camera/image_raw"));
+  EXPECT_TRUE(all_but_raw_images.is_selected("/camera/image_compressed"));
+  EXPECT_FALSE(listed_but_raw_images.is_selected("/camera/image_raw"));
+  EXPECT_TRUE(listed_but_raw_images.is_selected("/camera/info"));
+}
+
+TEST(TopicFilterTest, drops_topic_names_matching_exclude_regex) {
+  TopicFilter some_excluded({"/camera/image_raw", "/camera/info"}, "", ".*/image_raw");
+  TopicFilter all_excluded({"/camera/image_raw"}, "", ".*/image_raw");
+
+  EXPECT_THAT(some_excluded.get_topic_names(), UnorderedElementsAre("/camera/info"));
+  EXPECT_TRUE(some_excluded.selects_fixed_topics());
+  EXPECT_THAT(all_excluded.get_topic_names(), IsEmpty());
+  EXPECT_TRUE(all_excluded.selects_fixed_topics());
+  EXPECT_FALSE(all_excluded.is_selected("/camera/info"));
+}
+
+TEST(TopicFilterTest, throws_on_invalid_regex) {
+  EXPECT_THROW(TopicFilter({}, "(", ""), std::regex_error);
+  EXPECT_THROW(TopicFilter({}, "", "[a-"), std::regex_error);
+}